@@ -44,9 +44,21 @@ double fitnessFunction(Chromosome &chromosome)
     return scoure;
 }
 
+// Rescore only the characters that differ from the parent.
+double deltaFitnessFunction(Chromosome &chromosome, Chromosome &parent, double parentFitness, const vector<pair<int, int>> &modifiedRanges)
+{
+    double scoure = parentFitness;
+    for (auto &range : modifiedRanges)
+        for (int i = range.first; i < range.second; i++)
+            scoure += (chromosome.c[i] == password[i]) - (parent.c[i] == password[i]);
+
+    return scoure;
+}
+
 int main()
 {
     GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 1000, 1.5, 20);
+    ga.setDeltaFitnessFunction(deltaFitnessFunction);
     ga.initializePopulation(2000);
     ga.terminationConditions.setFitnessGoal(p_size);
     auto bestIndividual = ga.solve();
@@ -0,0 +1,55 @@
+/**
+ * @file find_password_tuner.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief tuning the settings of the genetic algorithm by racing
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include <iostream>
+#include "Tuner.h"
+
+using namespace std;
+
+char password[] = "Ali Marouf ali marouf ALI MAROUF 2022";
+
+const int p_size = sizeof(password) - 1; // -1 to ignore '\0' char
+
+// The chromosome represents the password.
+struct Chromosome
+{
+    char c[p_size];
+};
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    double scoure = 0;
+    for (int i = 0; i < p_size; i++)
+        if (chromosome.c[i] == password[i])
+            ++scoure;
+
+    return scoure;
+}
+
+int main()
+{
+    Tuner<Chromosome> tuner(fitnessFunction, true);
+    tuner.addGrid({0.5, 1.5, 4}, {10, 20}, {Selection::Fast, Selection::MixSelection}, {Crossover::Uniform, Crossover::MixCrossover}, {200});
+    tuner.setThreadsCount(0); // on all hardware threads
+
+    // 5 seeds per configuration, 300 generations, race every 50 generations
+    auto results = tuner.tune(5, 300, 50);
+
+    for (auto &result : results)
+    {
+        cout << result.configuration.toString() << "\n\t";
+        if (result.eliminated)
+            cout << "eliminated after " << result.generations << " generations, ";
+        cout << "fitness " << result.mean << " [" << result.low << ", " << result.high << "], mean rank " << result.meanRank << "\n";
+    }
+    cout << "Generations run: " << tuner.getGenerationsCount() << " instead of " << results.size() * 5 * 300 << "\n";
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file furniture_manufacturer_pareto.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief solving a multi-objective problem using GA
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include <iostream>
+#include "GeneticAlgorithm.h"
+using namespace std;
+
+// The furniture manufacturer of furniture_manufacturer.cpp wants to see the trade-off between
+// the profit and the total labor hours, instead of the single plan with the highest profit.
+// Manufacturing a chair requires 3 hours of carpentry, 9 hours of finishing, and 2 hours of upholstery.
+// Manufacturing a sofa requires 2 hours of carpentry, 4 hours of finishing, and 10 hours of upholstery.
+// The factory has allocated at most 66 labor hours for carpentry, 180 labor hours for finishing, and 200 labor hours for upholstery.
+// The profit per chair is $90 and the profit per sofa is $75.
+
+struct Chromosome
+{
+    byte chairs;
+    byte sofas;
+};
+
+// objectives: maximize the profit, minimize the labor hours
+vector<double> objectivesFunction(Chromosome &chromosome)
+{
+    int chairs = chromosome.chairs % 21; // [0,20]
+    int sofas = chromosome.sofas % 21;   // [0,20]
+
+    int carpentry = 3 * chairs + 2 * sofas;
+    int finishing = 9 * chairs + 4 * sofas;
+    int upholstery = 2 * chairs + 10 * sofas;
+
+    if (carpentry > 66 || finishing > 180 || upholstery > 200) // if out of range
+        return {-1e9, 1e9};                                    // return very bad objectives
+
+    return {90.0 * chairs + 75.0 * sofas, (double)(carpentry + finishing + upholstery)};
+}
+
+int main()
+{
+    GeneticAlgorithm<Chromosome> ga(objectivesFunction, {true, false}, 100, 2);
+    ga.initializePopulation(100);
+    ga.solve();
+
+    vector<Individual<Chromosome>> front = ga.getParetoFront();
+    sort(front.begin(), front.end(), [](Individual<Chromosome> a, Individual<Chromosome> b) -> bool
+         { return a.getObjectives()[0] < b.getObjectives()[0]; });
+
+    for (int i = 0; i < (int)front.size(); i++)
+    {
+        Individual<Chromosome> &plan = front[i];
+        if (i > 0 && plan.getObjectives() == front[i - 1].getObjectives()) // same plan
+            continue;
+        cout << "Chairs = " << plan.getChromosome().chairs % 21 << ", Sofas = " << plan.getChromosome().sofas % 21
+             << ", $ = " << plan.getObjectives()[0] << ", Hours = " << plan.getObjectives()[1] << "\n";
+    }
+    return 0;
+}
@@ -25,19 +25,15 @@ using namespace std;
 // 30/0.5 = 60, 3200/60 = 53, 180/3 = 60 => at most 53 split-level house
 // 30/1 = 30, 3200/80 = 40, 180/4 = 45 => at most 30 ranch house
 
-struct Chromosome
+// The genes decode straight into their ranges, Gray coded: one more house is one bit flip away.
+typedef GeneSchema<IntGene<0, 45, true>, // colonial
+                   IntGene<0, 53, true>, // split_level
+                   IntGene<0, 30, true>> // ranch
+    Houses;
+typedef Houses::Chromosome Chromosome;
+
+double profit(int64_t colonial, int64_t split_level, int64_t ranch)
 {
-    byte colonial;
-    byte split_level;
-    byte ranch;
-};
-
-double fitnessFunction(Chromosome chromosome)
-{
-    int colonial = chromosome.colonial % 46;       // [0,45]
-    int split_level = chromosome.split_level % 54; // [0,53]
-    int ranch = chromosome.ranch % 31;             // [0,30]
-
     double acre = 0.5 * colonial + 0.5 * split_level + ranch;
     int capital = 60 * colonial + 60 * split_level + 80 * ranch;
     int labor_hours = 4 * colonial + 3 * split_level + 4 * ranch;
@@ -50,10 +46,10 @@ double fitnessFunction(Chromosome chromosome)
 
 int main()
 {
-    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 200, 2, 30);
+    GeneticAlgorithm<Chromosome> ga(Houses::fitness(profit), true, 200, 2, 30);
     ga.initializePopulation(400);
     auto bestFound = ga.solve();
-    cout << "Best: colonial = " << bestFound.getChromosome().colonial % 46 << ", split_level = " << bestFound.getChromosome().split_level % 54 << ", ranch = " << bestFound.getChromosome().ranch % 31 << ", $ = " << bestFound.getFitness() << "\n";
+    cout << "Best: colonial = " << Houses::get<0>(bestFound.getChromosome()) << ", split_level = " << Houses::get<1>(bestFound.getChromosome()) << ", ranch = " << Houses::get<2>(bestFound.getChromosome()) << ", $ = " << bestFound.getFitness() << "\n";
     // Best: colonial = 20, split_level = 28, ranch = 4, $ = 1000
     // or
     // Best: colonial = 20, split_level = 20, ranch = 10, $ = 1000
@@ -0,0 +1,49 @@
+/**
+ * @file multi_peak_function_de.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief solving a maximization problem using GA and Differential Evolution
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include <iostream>
+#include "GeneticAlgorithm.h"
+using namespace std;
+
+// In the range [-205, 205] what is the maximum value of the function $f(x) = x * (0.4 + sin(x / 2))$.
+
+double fitnessFunction(float chromosome)
+{
+    float x = chromosome;
+
+    if (isnan(x) || isinf(x)) // if bad chromosome
+        return -1e9;          // return very low fitness
+
+    if (x > 205 || x < -205) // if out of range [-205,205]
+        return -1e9;         // return very low fitness
+
+    return x * (0.4 + sin(x / 2));
+}
+
+int main()
+{
+    // The same fitness function with both engines
+    GeneticAlgorithm<float> ga(fitnessFunction, true, 1500, 2, 30);
+    ga.setVerbose(false);
+    ga.initializePopulation(500);
+    ga.terminationConditions.setMaxIterations(200);
+    auto best = ga.solve();
+    std::cout << "GA: f(" << best.getChromosome() << ") = " << best.getFitness() << "\tevaluations: " << ga.getEvaluationsCount() << "\n";
+
+    // The genes of the chromosome are floats in [-205, 205]
+    DifferentialEvolution<float> de(fitnessFunction, true, -205, 205, 1500, CurrentToPBest);
+    de.setVerbose(false);
+    de.initializePopulation(30);
+    de.terminationConditions.setMaxIterations(50);
+    best = de.solve();
+    std::cout << "DE: f(" << best.getChromosome() << ") = " << best.getFitness() << "\tevaluations: " << de.getEvaluationsCount() << "\n";
+    // DE: f(204.231) = 285.904
+    return 0;
+}
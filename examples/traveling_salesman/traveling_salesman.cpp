@@ -43,36 +43,11 @@ struct Chromosome
     byte city[sz];
 };
 
-void fixChromosome(Chromosome &chromosome)
+// Make each tour visit every city once, a block of tours at a time, without allocating.
+void repairTours(Chromosome *chromosomes, int count, ScratchArena &arena)
 {
-    vector<int> pos[sz];
-    for (int i = 0; i < sz; i++)
-    {
-        int city = chromosome.city[i] % sz;
-        pos[city].push_back(i);
-    }
-
-    vector<int> missing, changePos;
-
-    // Find duplicate and missing items.
-    for (int i = 0; i < sz; i++)
-        if (pos[i].size() > 1) // duplicate item
-        {
-            random_shuffle(pos[i].begin(), pos[i].end());
-            for (int j = 0; j < pos[i].size() - 1; j++)
-                changePos.push_back(pos[i][j]);
-        }
-        else if (pos[i].empty()) // missing item
-            missing.push_back(i);
-
-    random_shuffle(missing.begin(), missing.end());
-
-    // Replace duplicate items with missing items.
-    for (int i = 0; i < missing.size(); i++)
-    {
-        int p = changePos[i];
-        chromosome.city[p] = missing[i];
-    }
+    for (int i = 0; i < count; i++)
+        repairPermutation(chromosomes[i].city, sz, arena);
 }
 
 #define DIS(c1, c2) sqrt(pow(c1.first - c2.first, 2) + pow(c1.second - c2.second, 2))
@@ -111,8 +86,11 @@ int main()
 {
     ga.setParentSelectionMethod(Selection::MixSelection);
     ga.setCrossoverMethod(Crossover::MixCrossover);
-    ga.setChromosomeFixFunction(fixChromosome);
+    ga.setBatchRepairFunction(repairTours);
     ga.setKickOutAge(20, false);
+    ga.setLocalSearch(LocalSearch::TwoOpt, 5, 200); // improve the 5 best new tours with 2-opt
+    ga.setThreadsCount(0);                          // on all hardware threads
+    ga.setPipelinedEvaluation(true, 32);            // evaluate chunks of 32 offspring while breeding the next ones
     ga.terminationConditions.setFitnessGoal(1010);
     // ga.terminationConditions.setMaxGeneration(3000);
     ga.terminationConditions.setMaxRunningTime_ms(10000); // 10 s
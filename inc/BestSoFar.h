@@ -0,0 +1,115 @@
+/**
+ * @file BestSoFar.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief BestSoFar Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef BESTSOFAR_H
+#define BESTSOFAR_H
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <string.h>
+#include <stdint.h>
+using namespace std;
+
+/**
+ * @brief The best chromosome found so far, published by the solving threads and read at any moment by other threads.
+ * Readers never block (seqlock): they retry while a new best is being written.
+ */
+template <class T>
+class BestSoFar
+{
+public:
+    BestSoFar() : words(new atomic<uint64_t>[wordsCount]), sequence(0), fitness(0), published(false), maximizeFitness(true)
+    {
+        for (int i = 0; i < wordsCount; i++)
+            words[i].store(0, memory_order_relaxed);
+    }
+
+    // Forget the published chromosome
+    void reset(bool maximizeFitness)
+    {
+        lock_guard<mutex> lock(writerMutex);
+        this->maximizeFitness = maximizeFitness;
+        published.store(false, memory_order_release);
+    }
+
+    // Publish the chromosome if it is better than the published one, return true if published
+    bool offer(const T &chromosome, double fitness)
+    {
+        if (isBetterOrEqual(this->fitness.load(memory_order_relaxed), fitness)) // fast path, most offers are not better
+            return false;
+
+        lock_guard<mutex> lock(writerMutex);
+        if (isBetterOrEqual(this->fitness.load(memory_order_relaxed), fitness))
+            return false;
+
+        uint64_t buffer[wordsCount] = {};
+        memcpy(buffer, &chromosome, sizeof(T));
+
+        uint64_t s = sequence.load(memory_order_relaxed);
+        sequence.store(s + 1, memory_order_relaxed); // odd: writing
+        atomic_thread_fence(memory_order_release);
+        for (int i = 0; i < wordsCount; i++)
+            words[i].store(buffer[i], memory_order_relaxed);
+        this->fitness.store(fitness, memory_order_relaxed);
+        published.store(true, memory_order_relaxed);
+        sequence.store(s + 2, memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Read a consistent copy of the best chromosome, lock-free
+     *
+     * @param[out] version the number of chromosomes published so far
+     * @return false if nothing is published yet
+     */
+    bool read(T &chromosome, double &fitness, uint64_t *version = nullptr) const
+    {
+        uint64_t buffer[wordsCount];
+        for (;;)
+        {
+            uint64_t s = sequence.load(memory_order_acquire);
+            if (s & 1)
+                continue;
+            bool hasValue = published.load(memory_order_relaxed);
+            for (int i = 0; i < wordsCount; i++)
+                buffer[i] = words[i].load(memory_order_relaxed);
+            fitness = this->fitness.load(memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            if (sequence.load(memory_order_relaxed) != s)
+                continue;
+
+            if (!hasValue)
+                return false;
+            memcpy(&chromosome, buffer, sizeof(T));
+            if (version)
+                *version = s / 2;
+            return true;
+        }
+    }
+
+private:
+    static const int wordsCount = (sizeof(T) + 7) / 8;
+    unique_ptr<atomic<uint64_t>[]> words;
+    atomic<uint64_t> sequence;
+    atomic<double> fitness;
+    atomic<bool> published;
+    bool maximizeFitness;
+    mutex writerMutex;
+
+    bool isBetterOrEqual(double current, double candidate)
+    {
+        if (!published.load(memory_order_relaxed))
+            return false;
+        return maximizeFitness ? current >= candidate : current <= candidate;
+    }
+};
+
+#endif
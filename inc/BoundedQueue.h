@@ -0,0 +1,95 @@
+/**
+ * @file BoundedQueue.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief BoundedQueue Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+using namespace std;
+
+// Thread-safe FIFO queue with a fixed capacity
+template <class T>
+class BoundedQueue
+{
+public:
+    BoundedQueue(int capacity = 1) : capacity(capacity), closed(false) {}
+
+    void setCapacity(int capacity) { this->capacity = capacity; }
+
+    // Add an item, wait while the queue is full. Return false if the queue is closed.
+    bool push(const T &item)
+    {
+        unique_lock<mutex> lock(queueMutex);
+        notFull.wait(lock, [this]
+                     { return closed || (int)items.size() < capacity; });
+        if (closed)
+            return false;
+        items.push(item);
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Add an item if the queue is not full and not closed
+    bool tryPush(const T &item)
+    {
+        lock_guard<mutex> lock(queueMutex);
+        if (closed || (int)items.size() >= capacity)
+            return false;
+        items.push(item);
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Take the oldest item, wait while the queue is empty. Return false if the queue is closed and empty.
+    bool pop(T &item)
+    {
+        unique_lock<mutex> lock(queueMutex);
+        notEmpty.wait(lock, [this]
+                      { return closed || !items.empty(); });
+        if (items.empty())
+            return false;
+        item = items.front();
+        items.pop();
+        notFull.notify_one();
+        return true;
+    }
+
+    // Take the oldest item if the queue is not empty
+    bool tryPop(T &item)
+    {
+        lock_guard<mutex> lock(queueMutex);
+        if (items.empty())
+            return false;
+        item = items.front();
+        items.pop();
+        notFull.notify_one();
+        return true;
+    }
+
+    // No more items can be pushed, waiting consumers return when the queue is empty
+    void close()
+    {
+        lock_guard<mutex> lock(queueMutex);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+private:
+    int capacity;
+    bool closed;
+    queue<T> items;
+    mutex queueMutex;
+    condition_variable notEmpty, notFull;
+};
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file CancellationToken.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief CancellationToken Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef CANCELLATIONTOKEN_H
+#define CANCELLATIONTOKEN_H
+
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+using namespace std;
+
+// Stop a running solve() from any thread, now or at a deadline
+class CancellationToken
+{
+public:
+    CancellationToken() : cancelled(false), deadline(INT64_MAX) {}
+
+    void cancel() { cancelled.store(true, memory_order_relaxed); }
+    // Cancel at %deadline%
+    void setDeadline(chrono::steady_clock::time_point deadline) { this->deadline.store(chrono::duration_cast<chrono::nanoseconds>(deadline.time_since_epoch()).count(), memory_order_relaxed); }
+    // Cancel %ms% milliseconds from now
+    void setDeadlineAfter_ms(double ms) { setDeadline(chrono::steady_clock::now() + chrono::nanoseconds((int64_t)(ms * 1e6))); }
+    // Clear the cancellation and the deadline, to use the token again
+    void reset()
+    {
+        cancelled.store(false, memory_order_relaxed);
+        deadline.store(INT64_MAX, memory_order_relaxed);
+    }
+
+    // Check if the token is cancelled or its deadline has passed
+    bool isCancelled()
+    {
+        if (cancelled.load(memory_order_relaxed))
+            return true;
+        int64_t d = deadline.load(memory_order_relaxed);
+        return d != INT64_MAX && chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count() >= d;
+    }
+
+private:
+    atomic<bool> cancelled;
+    atomic<int64_t> deadline; // steady clock nanoseconds
+};
+
+#endif
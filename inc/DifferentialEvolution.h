@@ -0,0 +1,408 @@
+/**
+ * @file DifferentialEvolution.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief DifferentialEvolution Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef DIFFERENTIALEVOLUTION_H
+#define DIFFERENTIALEVOLUTION_H
+
+#include "Individual.h"
+#include "TerminationConditions.h"
+#include "ThreadPool.h"
+#include "Random.h"
+#include <vector>
+#include <memory>
+#include <math.h>
+#include <algorithm>
+#include <iostream>
+#include <functional>
+#include <type_traits>
+using namespace std;
+
+enum DEStrategy
+{
+    RandOneBin,    // v = x_r0 + F (x_r1 - x_r2)
+    BestOneBin,    // v = x_best + F (x_r1 - x_r2)
+    CurrentToPBest // v = x_i + F (x_pbest - x_i) + F (x_r1 - x_r2), x_r2 from the population and the archive (JADE)
+};
+
+/**
+ * @brief Differential Evolution for continuous problems: the chromosome T is a structure of genes of type G (a float, a double,
+ * a structure of doubles...) and each trial vector is built from the difference of other individuals, then replaces its parent if it is not worse.
+ * It takes the same fitness function as GeneticAlgorithm<T>, the same termination conditions and returns the same Individual<T>.
+ *
+ * @note Each trial draws its random numbers from its own stream (seed, generation, index), so a run gives the same result on any number of threads.
+ * The termination conditions on the bits of the population (diversity, converged alleles, fitness band) are not used.
+ * @tparam T the type of the chromosome structure, made of genes of type G only
+ * @tparam G the type of a gene, T itself when T is a number, double otherwise
+ */
+template <class T, class G = typename conditional<is_arithmetic<T>::value, T, double>::type>
+class DifferentialEvolution
+{
+public:
+    static_assert(is_floating_point<G>::value, "The genes are floating point numbers");
+    static_assert(sizeof(T) % sizeof(G) == 0, "The chromosome is made of genes of type G");
+
+    /**
+     * @brief Construct a new Differential Evolution object
+     *
+     * @param fitnessFunction defines by user 'double fitness(T& chromosome)'
+     * @param maximizeFitness true to Maximize the fitness, false to Minimize the fitness
+     * @param lower the lower bound of every gene
+     * @param upper the upper bound of every gene
+     * @param maxGeneration put -1 for infinite generations
+     * @param strategy the mutation strategy: 'RandOneBin, BestOneBin, CurrentToPBest'
+     */
+    DifferentialEvolution(function<double(T &)> fitnessFunction, bool maximizeFitness, G lower, G upper, uint64_t maxGeneration = 1000, DEStrategy strategy = CurrentToPBest)
+        : fitnessFunction(fitnessFunction), maximizeFitness(maximizeFitness), lower(dimensions(), lower), upper(dimensions(), upper), strategy(strategy)
+    {
+        assert((lower <= upper) && "Invalid bounds");
+        terminationConditions.setMaxGeneration(maxGeneration);
+        seed = ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+    }
+
+    static constexpr int dimensions() { return (int)(sizeof(T) / sizeof(G)); }
+
+    // The bounds of each gene, the trial genes out of the bounds are moved half way back to the parent gene
+    void setBounds(const vector<G> &lower, const vector<G> &upper)
+    {
+        assert(((int)lower.size() == dimensions() && (int)upper.size() == dimensions()) && "One bound per gene");
+        this->lower = lower;
+        this->upper = upper;
+    }
+    void setStrategy(DEStrategy strategy) { this->strategy = strategy; }
+    DEStrategy getStrategy() { return strategy; }
+    /**
+     * @brief The scale factor F and the crossover rate CR (the start means of the adaptive parameters when the adaptation is on), 0.8 and 0.9 by default.
+     * BestOneBin needs a large F, with F = 0.5 the population falls on the best individual before reaching the optimum.
+     */
+    void setParameters(double F, double CR)
+    {
+        assert((F > 0 && CR >= 0 && CR <= 1) && "Invalid parameters");
+        this->F = F;
+        this->CR = CR;
+    }
+    /**
+     * @brief JADE adaptation (Zhang & Sanderson, 2009): each trial draws F from Cauchy(meanF, 0.1) and CR from Normal(meanCR, 0.1),
+     * the means move toward the parameters of the successful trials (Lehmer mean for F, arithmetic mean for CR) at rate %c%.
+     * Enabled by default with CurrentToPBest.
+     *
+     * @param c the learning rate of the means
+     * @param p CurrentToPBest picks x_pbest among the best p * population size individuals
+     */
+    void setAdaptation(bool enabled, double c = 0.1, double p = 0.05)
+    {
+        assert((c > 0 && c <= 1 && p > 0 && p <= 1) && "Invalid adaptation");
+        adaptation = enabled;
+        this->c = c;
+        this->p = p;
+    }
+    bool isAdaptationEnabled() { return adaptation; }
+    // The current means of the adaptive parameters
+    double getMeanF() { return meanF; }
+    double getMeanCR() { return meanCR; }
+
+    // The random numbers come from the streams of %seed%, the same seed gives the same run
+    void setSeed(uint64_t seed) { this->seed = seed; }
+    void setVerbose(bool verbose) { this->verbose = verbose; }
+    // Evaluate the trials on %threadsCount% threads (0: all hardware threads), 1 to evaluate them on the calling thread
+    void setThreadsCount(int threadsCount)
+    {
+        if (threadsCount == 1)
+            threadPool.reset();
+        else
+            threadPool = make_shared<ThreadPool>(threadsCount);
+    }
+    // Share a thread pool with other solvers
+    void setThreadPool(shared_ptr<ThreadPool> threadPool) { this->threadPool = threadPool; }
+
+    // Initialize population from predefined vector
+    void initializePopulation(vector<Individual<T>> &population)
+    {
+        assert((population.size() >= 4) && "The population needs at least 4 individuals");
+        this->population = population;
+        populationSize = (int)population.size();
+        evaluations = 0;
+        resetAdaptation();
+    }
+    // Initialize population with random chromosomes, uniform in the bounds
+    void initializePopulation(int size)
+    {
+        assert((size >= 4) && "The population needs at least 4 individuals");
+        populationSize = size;
+        vector<T> chromosomes(size);
+        for (int i = 0; i < size; i++)
+        {
+            RandomStream stream(seed, 0xFFFFFFFF, (uint32_t)i);
+            G *genes = (G *)&chromosomes[i];
+            for (int d = 0; d < dimensions(); d++)
+                genes[d] = (G)(lower[d] + uniform(stream) * (upper[d] - lower[d]));
+        }
+        vector<double> fitness(size);
+        evaluate(chromosomes, fitness);
+        population.clear();
+        for (int i = 0; i < size; i++)
+            population.push_back(Individual<T>(fitnessFunction, chromosomes[i], fitness[i], 0));
+        evaluations = size;
+        resetAdaptation();
+    }
+
+    Individual<T> solve()
+    {
+        assert((!population.empty()) && "No population, use initializePopulation(size)");
+        if (verbose)
+            cout << "Start solving...\nMax Generation: " << terminationConditions.maxGeneration << "\n";
+        terminationConditions.isFirstTime = true;
+        terminationConditions.maximizeFitness = maximizeFitness;
+        terminationConditions.setStartTime();
+        terminationConditions.resetSlope();
+        for (generation = 0;; generation++)
+        {
+            double bestFitness = population[bestIndex()].getFitness();
+            if (verbose)
+                cout << "Generation: " << generation << "\tFitness: " << bestFitness << "\n";
+            if (generation == terminationConditions.maxGeneration)
+            {
+                if (verbose)
+                    cout << "Done with best fitness: " << bestFitness << "\n";
+                break;
+            }
+            if (terminationConditions.checkTimeCondition())
+            {
+                if (verbose)
+                    cout << "Timeout\n";
+                break;
+            }
+            if (terminationConditions.checkFitnessGoalCondition(bestFitness))
+            {
+                if (verbose)
+                    cout << "Reached to fitness goal: " << bestFitness << "\n";
+                break;
+            }
+            if (terminationConditions.checkIterationsCondition(bestFitness))
+            {
+                if (verbose)
+                    cout << "Reached to max iterations\n";
+                break;
+            }
+            if (terminationConditions.checkSlopeCondition(bestFitness))
+            {
+                if (verbose)
+                    cout << "Reached to min improvement slope\n";
+                break;
+            }
+            runGeneration();
+        }
+        return getBestIndividual();
+    }
+
+    Individual<T> getBestIndividual() { return population[bestIndex()]; }
+    vector<Individual<T>> &getPopulation() { return population; }
+    uint64_t getGeneration() { return generation; }
+    // Number of calls to the fitness function since the population was initialized
+    uint64_t getEvaluationsCount() { return evaluations; }
+
+    TerminationConditions terminationConditions;
+
+private:
+    function<double(T &)> fitnessFunction;
+    bool maximizeFitness;
+    vector<G> lower, upper;
+    DEStrategy strategy;
+    double F = 0.8, CR = 0.9;
+    bool adaptation = true;
+    double c = 0.1, p = 0.05;
+    double meanF, meanCR;
+    uint64_t seed;
+    bool verbose = true;
+    shared_ptr<ThreadPool> threadPool;
+
+    vector<Individual<T>> population;
+    int populationSize = 0;
+    uint64_t generation = 0;
+    uint64_t evaluations = 0;
+    vector<T> archive; // the parents replaced by better trials (CurrentToPBest)
+
+    // The parameters of a trial
+    struct Trial
+    {
+        double F, CR;
+    };
+
+    bool isAdaptive() { return adaptation && strategy == CurrentToPBest; }
+
+    void resetAdaptation()
+    {
+        meanF = F;
+        meanCR = CR;
+        archive.clear();
+    }
+
+    static constexpr double pi() { return 3.14159265358979323846; }
+    // A random number in [0, 1[
+    static double uniform(RandomStream &stream) { return stream.next() * (1.0 / 4294967296.0); }
+
+    bool isBetter(double a, double b) { return maximizeFitness ? a > b : a < b; }
+
+    int bestIndex()
+    {
+        int best = 0;
+        for (int i = 1; i < (int)population.size(); i++)
+            if (isBetter(population[i].getFitness(), population[best].getFitness()))
+                best = i;
+        return best;
+    }
+
+    void parallelFor(int count, function<void(int)> task)
+    {
+        if (threadPool)
+            threadPool->parallelFor(0, count, task);
+        else
+            for (int i = 0; i < count; i++)
+                task(i);
+    }
+
+    void evaluate(vector<T> &chromosomes, vector<double> &fitness)
+    {
+        parallelFor((int)chromosomes.size(), [this, &chromosomes, &fitness](int i)
+                    { fitness[i] = fitnessFunction(chromosomes[i]); });
+    }
+
+    // A random index in [0, count[ different from the %excludedCount% first values of %excluded%
+    static int pick(RandomStream &stream, int count, const int *excluded, int excludedCount)
+    {
+        for (;;)
+        {
+            int r = (int)(uniform(stream) * count);
+            bool taken = false;
+            for (int k = 0; k < excludedCount; k++)
+                taken = taken || r == excluded[k];
+            if (!taken)
+                return r;
+        }
+    }
+
+    Trial drawParameters(RandomStream &stream)
+    {
+        Trial trial = {F, CR};
+        if (!isAdaptive())
+            return trial;
+        do // Cauchy(meanF, 0.1), drawn again when not positive, truncated to 1
+            trial.F = meanF + 0.1 * tan(pi() * (uniform(stream) - 0.5));
+        while (trial.F <= 0);
+        trial.F = min(trial.F, 1.0);
+        // Normal(meanCR, 0.1) by Box-Muller, clamped into [0, 1]
+        double u1 = 1.0 - uniform(stream), u2 = uniform(stream);
+        trial.CR = meanCR + 0.1 * sqrt(-2.0 * log(u1)) * cos(2 * pi() * u2);
+        trial.CR = min(max(trial.CR, 0.0), 1.0);
+        return trial;
+    }
+
+    /**
+     * @brief Build the trial vector of individual %i%: v = base + K (pbest - x) + F (r1 - r2), crossed with x gene by gene.
+     * The strategies only choose the vectors, the loop over the genes has no call and no branch, so it vectorizes.
+     */
+    void buildTrial(int i, const vector<int> &ranking, const T &best, T &trial, Trial &parameters, G *mask)
+    {
+        RandomStream stream(seed, (uint32_t)generation, (uint32_t)i);
+        parameters = drawParameters(stream);
+
+        const int excluded[] = {i};
+        int r0 = strategy == RandOneBin ? pick(stream, populationSize, excluded, 1) : i;
+        const int excluded1[] = {i, r0};
+        int r1 = pick(stream, populationSize, excluded1, 2);
+        const int excluded2[] = {i, r0, r1};
+        int r2 = pick(stream, populationSize + (strategy == CurrentToPBest ? (int)archive.size() : 0), excluded2, 3);
+
+        const G *x = (const G *)population[i].getChromosomePointer();
+        const G *base = strategy == RandOneBin ? (const G *)population[r0].getChromosomePointer() : (strategy == BestOneBin ? (const G *)&best : x);
+        const G *pbest = x;
+        G K = 0;
+        if (strategy == CurrentToPBest)
+        {
+            int top = max(1, (int)(p * populationSize + 0.5));
+            pbest = (const G *)population[ranking[(int)(uniform(stream) * top)]].getChromosomePointer();
+            K = (G)parameters.F;
+        }
+        const G *a = (const G *)population[r1].getChromosomePointer();
+        const G *b = r2 < populationSize ? (const G *)population[r2].getChromosomePointer() : (const G *)&archive[r2 - populationSize];
+        const G Fg = (G)parameters.F;
+        const int forced = (int)(uniform(stream) * dimensions()); // at least one gene comes from the mutant
+        for (int d = 0; d < dimensions(); d++)
+            mask[d] = (G)(uniform(stream) < parameters.CR || d == forced);
+
+        // The selects are products with the 0/1 masks: a conditional expression would become a branch (the floating point
+        // operations may trap, so they are not speculated) and the loop would not vectorize.
+        G *v = (G *)&trial;
+        const G *lo = lower.data(), *hi = upper.data();
+        for (int d = 0; d < dimensions(); d++)
+        {
+            G mutant = base[d] + K * (pbest[d] - x[d]) + Fg * (a[d] - b[d]);
+            G below = (G)(mutant < lo[d]), above = (G)(mutant > hi[d]);
+            mutant = below * ((lo[d] + x[d]) / 2) + above * ((hi[d] + x[d]) / 2) + (1 - below - above) * mutant;
+            v[d] = mask[d] * mutant + (1 - mask[d]) * x[d];
+        }
+    }
+
+    void runGeneration()
+    {
+        vector<int> ranking(populationSize);
+        for (int i = 0; i < populationSize; i++)
+            ranking[i] = i;
+        if (strategy == CurrentToPBest)
+            sort(ranking.begin(), ranking.end(), [this](int a, int b)
+                 { return isBetter(population[a].getFitness(), population[b].getFitness()) || (population[a].getFitness() == population[b].getFitness() && a < b); });
+        T best = population[bestIndex()].getChromosome();
+
+        vector<T> trials(populationSize);
+        vector<Trial> parameters(populationSize);
+        vector<double> fitness(populationSize);
+        parallelFor(populationSize, [this, &ranking, &best, &trials, &parameters, &fitness](int i)
+                    {
+                        G mask[dimensions()];
+                        buildTrial(i, ranking, best, trials[i], parameters[i], mask);
+                        fitness[i] = fitnessFunction(trials[i]); });
+        evaluations += populationSize;
+
+        // Selection: a trial replaces its parent if it is not worse
+        double sumF = 0, sumF2 = 0, sumCR = 0;
+        int successes = 0;
+        RandomStream stream(seed, (uint32_t)generation, 0xFFFFFFFF);
+        for (int i = 0; i < populationSize; i++)
+        {
+            if (isBetter(population[i].getFitness(), fitness[i]))
+            {
+                population[i].increaseAge();
+                continue;
+            }
+            if (isBetter(fitness[i], population[i].getFitness()))
+            {
+                sumF += parameters[i].F;
+                sumF2 += parameters[i].F * parameters[i].F;
+                sumCR += parameters[i].CR;
+                ++successes;
+                if (strategy == CurrentToPBest)
+                {
+                    if ((int)archive.size() < populationSize)
+                        archive.push_back(population[i].getChromosome());
+                    else
+                        archive[(int)(uniform(stream) * populationSize)] = population[i].getChromosome();
+                }
+            }
+            population[i] = Individual<T>(fitnessFunction, trials[i], fitness[i], 0);
+        }
+
+        if (isAdaptive() && successes > 0)
+        {
+            meanCR = (1 - c) * meanCR + c * sumCR / successes;
+            meanF = (1 - c) * meanF + c * sumF2 / sumF; // Lehmer mean
+        }
+    }
+};
+
+#endif
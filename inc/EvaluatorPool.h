@@ -0,0 +1,108 @@
+/**
+ * @file EvaluatorPool.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief EvaluatorPool Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef EVALUATORPOOL_H
+#define EVALUATORPOOL_H
+
+#include <stdint.h>
+#include <vector>
+#include <functional>
+using namespace std;
+
+#if defined(__unix__) || defined(__APPLE__)
+#define EVALUATOR_POOL_PROCESSES 1
+#include <sys/types.h>
+#else
+#define EVALUATOR_POOL_PROCESSES 0
+#endif
+
+/**
+ * @brief Evaluate chromosomes in worker processes, so a fitness function that is not thread-safe, hangs or crashes
+ * can not stop the caller. The chromosome bytes are sent over sockets in batches, and every fitness is sent back as soon as it is ready.
+ * A worker that takes more than the timeout on one chromosome, or dies, is killed and respawned,
+ * and that chromosome gets the penalty fitness.
+ *
+ * The constructor forks one helper process (a zygote) and the zygote forks every worker, the first ones and the respawned ones,
+ * then sends its socket back. The zygote has a single thread and only makes async-signal-safe calls, so respawning a worker
+ * in the middle of a run never forks the caller while its other threads hold locks.
+ * @note Construct the pool before starting any thread (setThreadsCount, a trace, ...): the zygote is a copy of the calling
+ * process at that moment, and so are the fitness function and the data it uses in every worker.
+ * Without fork (not POSIX), the chromosomes are evaluated in the calling process, without timeouts.
+ */
+class EvaluatorPool
+{
+public:
+    /**
+     * @brief Construct a new Evaluator Pool object and start the worker processes
+     *
+     * @param processesCount number of worker processes, put 0 to use all hardware threads
+     * @param chromosomeSize the size of the chromosome in bytes
+     * @param fitnessFunction the fitness of the chromosome bytes, called in the worker processes
+     * @param timeout_ms max time of one evaluation in milliseconds, put 0 for no timeout
+     * @param penaltyFitness the fitness of the chromosomes whose evaluation timed out or crashed
+     * @param batchSize max chromosomes per message
+     */
+    EvaluatorPool(int processesCount, int chromosomeSize, function<double(uint8_t *)> fitnessFunction, double timeout_ms = 0, double penaltyFitness = 0, int batchSize = 16);
+    ~EvaluatorPool();
+
+    /**
+     * @brief Evaluate %count% chromosomes stored one after another, and wait for all of them
+     * @note Call it from one thread at a time.
+     *
+     * @param chromosomes count * chromosomeSize bytes
+     * @param[out] fitness count values
+     * @return false if some chromosomes were not evaluated by a worker: no worker could be started and they were evaluated
+     * in this process (getInProcessCount), or waiting for the workers failed and their fitness is NaN (getLostCount)
+     */
+    bool evaluate(uint8_t *chromosomes, int count, double *fitness);
+
+    int size() { return processesCount; }
+    // Number of evaluations that took longer than the timeout
+    uint64_t getTimeoutsCount() { return timeoutsCount; }
+    // Number of evaluations during which the worker process died
+    uint64_t getCrashesCount() { return crashesCount; }
+    // Number of chromosomes evaluated in the calling process because no worker process could be started
+    uint64_t getInProcessCount() { return inProcessCount; }
+    // Number of chromosomes left with a NaN fitness because waiting for the workers failed
+    uint64_t getLostCount() { return lostCount; }
+
+private:
+    int processesCount, chromosomeSize, batchSize;
+    function<double(uint8_t *)> fitnessFunction;
+    double timeout_ms, penaltyFitness;
+    uint64_t timeoutsCount, crashesCount, inProcessCount, lostCount;
+
+#if EVALUATOR_POOL_PROCESSES
+    struct Worker
+    {
+        pid_t pid;
+        int channel; // socket of the parent
+        int first, count, received;
+        vector<uint8_t> partial; // bytes of an incomplete fitness
+        double deadline;
+    };
+    vector<Worker> workers;
+    pid_t zygotePid;
+    int zygote; // socket of the parent to the zygote, -1 if it is gone
+
+    // Ask the zygote for a new worker
+    void spawn(Worker &worker);
+    // Close the socket of the worker, the zygote kills and reaps it
+    void kill(Worker &worker);
+    // Send the batch [first, first + count[ to an idle worker
+    bool send(Worker &worker, uint8_t *chromosomes, int first, int count);
+    // Run by the zygote process, never returns. %children% has room for all the workers, so the zygote does not allocate.
+    void zygoteLoop(int control, vector<pid_t> &children);
+    // Run by the worker process, never returns
+    void workerLoop(int channel);
+#endif
+};
+
+#endif
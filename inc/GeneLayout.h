@@ -0,0 +1,46 @@
+/**
+ * @file GeneLayout.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief GeneLayout Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef GENELAYOUT_H
+#define GENELAYOUT_H
+
+#include <stddef.h>
+#include <vector>
+using namespace std;
+
+// Offset and size of the field %member% of the chromosome structure %T%, for GeneLayout::add
+#define GENE_FIELD(T, member) offsetof(T, member), sizeof(((T *)0)->member)
+// Offset, element size and length of the array field %member% of the chromosome structure %T%, for GeneLayout::addArray
+#define GENE_ARRAY(T, member) offsetof(T, member), sizeof(((T *)0)->member[0]), (int)(sizeof(((T *)0)->member) / sizeof(((T *)0)->member[0]))
+
+/**
+ * @brief Where the genes are in the chromosome structure, so the one-point and two-point crossovers cut only between two genes
+ * and a multi-byte gene (int, double...) always comes whole from one parent.
+ */
+class GeneLayout
+{
+public:
+    // A gene of %size% bytes at byte %offset%
+    GeneLayout &add(size_t offset, size_t size);
+    // %count% genes of %size% bytes each, from byte %offset% (an array field)
+    GeneLayout &addArray(size_t offset, size_t size, int count);
+
+    int size() const { return (int)offsets.size(); }
+    bool empty() const { return offsets.empty(); }
+    int getOffset(int gene) const { return offsets[gene]; }
+    int getSize(int gene) const { return sizes[gene]; }
+    // Check that the genes are in order, do not overlap and fit in %chromosomeSize% bytes
+    bool isValid(int chromosomeSize) const;
+
+private:
+    vector<int> offsets, sizes;
+};
+
+#endif
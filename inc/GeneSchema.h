@@ -0,0 +1,249 @@
+/**
+ * @file GeneSchema.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief Typed gene schemas are a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef GENESCHEMA_H
+#define GENESCHEMA_H
+
+#include <stdint.h>
+#include <tuple>
+#include <functional>
+using namespace std;
+
+// Number of bits needed to hold %values% different codes
+constexpr int geneBits(uint64_t values, int bits = 0)
+{
+    return (1ULL << bits) >= values ? bits : geneBits(values, bits + 1);
+}
+
+constexpr uint64_t genePowerOfTen(int points)
+{
+    return points == 0 ? 1 : 10 * genePowerOfTen(points - 1);
+}
+
+/**
+ * @brief The codes of a gene with %Count% values: the raw bits r of the gene give the value index (r * Count) >> bits,
+ * a multiply and a shift, every code is valid and close codes give close values.
+ * Each value has 1 or 2 codes, exactly 1 when Count is a power of 2.
+ * @note With %Gray% the raw bits are a Gray code, two neighbour values are one bit flip apart (no Hamming cliff).
+ */
+template <uint64_t Count, bool Gray>
+struct GeneCode
+{
+    static_assert(Count >= 1 && geneBits(Count) <= 32, "A gene holds 1 to 2^32 values");
+    static constexpr uint64_t count() { return Count; }
+    static constexpr int bits() { return geneBits(Count); }
+    static constexpr bool gray() { return Gray; }
+    static uint64_t index(uint64_t code) { return (code * Count) >> bits(); }
+    // The first code of the value index %index%
+    static uint64_t code(uint64_t index) { return ((index << bits()) + Count - 1) / Count; }
+};
+
+// An integer in [Min, Max]
+template <int64_t Min, int64_t Max, bool Gray = false>
+struct IntGene : GeneCode<(uint64_t)(Max - Min) + 1, Gray>
+{
+    typedef int64_t value_type;
+    static value_type decode(uint64_t code) { return Min + (int64_t)IntGene::index(code); }
+    static uint64_t encode(value_type value) { return IntGene::code((uint64_t)(value - Min)); }
+};
+
+// A fixed-point number in [Min, Max] with %Points% decimal digits
+template <int64_t Min, int64_t Max, int Points, bool Gray = false>
+struct FixedGene : GeneCode<(uint64_t)(Max - Min) * genePowerOfTen(Points) + 1, Gray>
+{
+    typedef double value_type;
+    static constexpr double step() { return 1.0 / genePowerOfTen(Points); }
+    static value_type decode(uint64_t code) { return Min + (double)FixedGene::index(code) * step(); }
+    static uint64_t encode(value_type value) { return FixedGene::code((uint64_t)((value - Min) * genePowerOfTen(Points) + 0.5)); }
+};
+
+// One of the %Count% first values of the enumeration %E%
+template <class E, int Count, bool Gray = false>
+struct EnumGene : GeneCode<Count, Gray>
+{
+    typedef E value_type;
+    static value_type decode(uint64_t code) { return (E)EnumGene::index(code); }
+    static uint64_t encode(value_type value) { return EnumGene::code((uint64_t)value); }
+};
+
+struct BoolGene : GeneCode<2, false>
+{
+    typedef bool value_type;
+    static value_type decode(uint64_t code) { return code != 0; }
+    static uint64_t encode(value_type value) { return value; }
+};
+
+// Total bits of the genes
+template <class... Genes>
+struct GeneSchemaBits
+{
+    static constexpr int value() { return 0; }
+};
+
+template <class First, class... Rest>
+struct GeneSchemaBits<First, Rest...>
+{
+    static constexpr int value() { return First::bits() + GeneSchemaBits<Rest...>::value(); }
+};
+
+// The type and the bit offset of gene %I%
+template <int I, class... Genes>
+struct GeneSchemaAt;
+
+template <class First, class... Rest>
+struct GeneSchemaAt<0, First, Rest...>
+{
+    typedef First type;
+    static constexpr int offset() { return 0; }
+};
+
+template <int I, class First, class... Rest>
+struct GeneSchemaAt<I, First, Rest...>
+{
+    typedef typename GeneSchemaAt<I - 1, Rest...>::type type;
+    static constexpr int offset() { return First::bits() + GeneSchemaAt<I - 1, Rest...>::offset(); }
+};
+
+template <int... I>
+struct GeneIndices
+{
+};
+
+template <int N, int... I>
+struct MakeGeneIndices : MakeGeneIndices<N - 1, N - 1, I...>
+{
+};
+
+template <int... I>
+struct MakeGeneIndices<0, I...>
+{
+    typedef GeneIndices<I...> type;
+};
+
+// The %Width% bits at bit %Offset% of %p%, the loops have constant bounds and unroll
+template <int Offset, int Width>
+inline uint64_t readGeneBits(const uint8_t *p)
+{
+    uint64_t word = 0;
+    for (int b = Offset / 8; b < (Offset + Width + 7) / 8; b++)
+        word |= (uint64_t)p[b] << (8 * (b - Offset / 8));
+    return (word >> (Offset % 8)) & ((1ULL << Width) - 1);
+}
+
+template <int Offset, int Width>
+inline void writeGeneBits(uint8_t *p, uint64_t code)
+{
+    const uint64_t mask = ((1ULL << Width) - 1) << (Offset % 8);
+    for (int b = Offset / 8; b < (Offset + Width + 7) / 8; b++)
+    {
+        const int shift = 8 * (b - Offset / 8);
+        p[b] = (uint8_t)((p[b] & ~(mask >> shift)) | (((code << (Offset % 8)) & mask) >> shift));
+    }
+}
+
+inline uint64_t grayToBinary(uint64_t code)
+{
+    code ^= code >> 16;
+    code ^= code >> 8;
+    code ^= code >> 4;
+    code ^= code >> 2;
+    code ^= code >> 1;
+    return code;
+}
+
+inline uint64_t binaryToGray(uint64_t code) { return code ^ (code >> 1); }
+
+/**
+ * @brief A chromosome made of typed genes packed bit by bit, with the widths and offsets computed at compile time.
+ * Decoding a gene reads its bits and maps them to the value with a multiply and a shift, no modulo, no divide, no branch.
+ *
+ * typedef GeneSchema<IntGene<0, 45>, FixedGene<-5, 5, 3, true>, BoolGene> Schema;
+ * GeneticAlgorithm<Schema::Chromosome> ga(Schema::fitness(f), ...); // double f(int64_t a, double b, bool c)
+ */
+template <class... Genes>
+class GeneSchema
+{
+public:
+    static_assert(sizeof...(Genes) > 0, "No genes");
+
+    struct Chromosome
+    {
+        uint8_t data[(GeneSchemaBits<Genes...>::value() + 7) / 8];
+    };
+
+    template <int I>
+    using Gene = typename GeneSchemaAt<I, Genes...>::type;
+    template <int I>
+    using Value = typename Gene<I>::value_type;
+
+    static constexpr int size() { return sizeof...(Genes); }
+    static constexpr int bits() { return GeneSchemaBits<Genes...>::value(); }
+    template <int I>
+    static constexpr int offset() { return GeneSchemaAt<I, Genes...>::offset(); }
+
+    // The value of gene %I%
+    template <int I>
+    static Value<I> get(const Chromosome &chromosome)
+    {
+        uint64_t code = readGeneBits<offset<I>(), Gene<I>::bits()>(chromosome.data);
+        return Gene<I>::decode(Gene<I>::gray() ? grayToBinary(code) : code);
+    }
+
+    // Give the value %value% to gene %I%
+    template <int I>
+    static void set(Chromosome &chromosome, Value<I> value)
+    {
+        uint64_t code = Gene<I>::encode(value);
+        writeGeneBits<offset<I>(), Gene<I>::bits()>(chromosome.data, Gene<I>::gray() ? binaryToGray(code) : code);
+    }
+
+    static tuple<typename Genes::value_type...> decode(const Chromosome &chromosome)
+    {
+        return decode(chromosome, typename MakeGeneIndices<sizeof...(Genes)>::type());
+    }
+
+    // Call f with the values of the genes
+    template <class F>
+    static double apply(F f, const Chromosome &chromosome)
+    {
+        return apply(f, chromosome, typename MakeGeneIndices<sizeof...(Genes)>::type());
+    }
+
+    // A fitness function of the chromosome from a function of the gene values
+    template <class F>
+    static function<double(Chromosome &)> fitness(F f)
+    {
+        return [f](Chromosome &chromosome) -> double
+        { return apply(f, chromosome); };
+    }
+
+    // Decode gene %I% of %count% chromosomes into %values%, one plain loop the compiler can vectorize (for batch evaluation)
+    template <int I>
+    static void decodeColumn(const Chromosome *chromosomes, int count, Value<I> *values)
+    {
+        for (int i = 0; i < count; i++)
+            values[i] = get<I>(chromosomes[i]);
+    }
+
+private:
+    template <int... I>
+    static tuple<typename Genes::value_type...> decode(const Chromosome &chromosome, GeneIndices<I...>)
+    {
+        return make_tuple(get<I>(chromosome)...);
+    }
+
+    template <class F, int... I>
+    static double apply(F f, const Chromosome &chromosome, GeneIndices<I...>)
+    {
+        return f(get<I>(chromosome)...);
+    }
+};
+
+#endif
@@ -13,6 +13,24 @@
 
 #include "Individual.h"
 #include "TerminationConditions.h"
+#include "Hamming.h"
+#include "MultiObjective.h"
+#include "OperatorSelector.h"
+#include "ThreadPool.h"
+#include "NumaTopology.h"
+#include "BoundedQueue.h"
+#include "EvaluatorPool.h"
+#include "MappedPopulation.h"
+#include "Random.h"
+#include "CancellationToken.h"
+#include "BestSoFar.h"
+#include "PopulationStatistics.h"
+#include "TraceWriter.h"
+#include "StatsPage.h"
+#include "Repair.h"
+#include "GeneLayout.h"
+#include "GeneSchema.h"
+#include "DifferentialEvolution.h"
 #include <vector>
 #include <memory>
 #include <math.h>
@@ -21,6 +39,10 @@
 #include <iostream>
 #include <functional>
 #include <chrono>
+#include <string.h>
+#include <unordered_map>
+#include <random>
+#include <atomic>
 using namespace std;
 
 #define GET_BIT(a, i) ((a >> i) & 1)
@@ -28,7 +50,7 @@ using namespace std;
 #define RESET_BIT(a, i) (a &= ~(1UL << i))
 #define CHANGE_BIT(a, i, b) (a = (a & ~(1UL << i)) | ((b > 0) << i))
 #define FLIP_BIT(a, b) ((a) ^= (1ULL << (b)))
-#define RANDOM(mx) (rand() % (mx))
+#define RANDOM(mx) ((int)(randomNext() % (uint32_t)(mx)))
 
 // 10 ^ p
 #define TEN(p) ((1e##p))
@@ -52,6 +74,16 @@ enum Crossover
     TwoPoint,
     MixCrossover
 };
+enum LocalSearch
+{
+    BitFlip,
+    TwoOpt
+};
+enum Niching
+{
+    FitnessSharing,
+    Clearing
+};
 
 template <class T>
 class GeneticAlgorithm
@@ -70,16 +102,111 @@ public:
      * @param crossover crossover method: 'Uniform, OnePoint, TwoPoint, MixCrossover'
      */
     GeneticAlgorithm(function<double(T &)> fitnessFunction, bool maximizeFitness = true, uint64_t maxGeneration = 500, double MutationPercentage = 1.5, double ElitePercentage = 15.0, Selection selection = Fast, Crossover crossover = Uniform);
+    /**
+     * @brief Construct a new multi-objective Genetic Algorithm object (NSGA-II)
+     * @note Each generation breeds a full population of offspring, ranks parents and offspring by non-dominated sorting and crowding distance,
+     * and keeps the best half. The fitness of an individual becomes its rank score, use getParetoFront() after solve().
+     *
+     * @tparam T the type of the chromosome structure
+     * @param objectivesFunction defines by user 'vector<double> objectives(T& chromosome)'
+     * @param maximizeObjectives maximizeObjectives[i] is true to Maximize objective i, false to Minimize it
+     * @param maxGeneration put -1 for infinite generations
+     * @param MutationPercentage Mutation percentage in the new generation
+     * @param selection parent selection method: 'Fast, RouletteWheel, MixSelection'
+     * @param crossover crossover method: 'Uniform, OnePoint, TwoPoint, MixCrossover'
+     */
+    GeneticAlgorithm(function<vector<double>(T &)> objectivesFunction, vector<bool> maximizeObjectives, uint64_t maxGeneration = 500, double MutationPercentage = 1.5, Selection selection = Fast, Crossover crossover = Uniform);
     ~GeneticAlgorithm();
 
-    T generateRandomChromosome();
+    // %repair%: fix the chromosome at once, false when the caller repairs a whole block later
+    T generateRandomChromosome(bool repair = true);
     // Initialize population from predefined vector
     void initializePopulation(vector<Individual<T>> &population);
     // Initialize population with random chromosomes
     void initializePopulation(int size);
+    /**
+     * @brief Initialize a population with random chromosomes kept in a memory-mapped file, for populations larger than the memory.
+     * Only the fitness and the age of the individuals stay in memory. The chromosomes are processed in chunks:
+     * the parents of a chunk are read in file order and the offspring are written one after another to the next generation.
+     * @note The mapped mode uses the selection and crossover methods, the elite, the fix function, the thread pool and the batch evaluation
+     * (asynchronous or evaluator pool). The other features that work on the population (delta, bounded, surrogate, multi-objective,
+     * duplicate elimination, adaptive operators, kick out, restarts, local search, diversity) are not used.
+     *
+     * @param size number of individuals
+     * @param path the file of the chromosomes, its size becomes 2 * size * sizeof(T) bytes
+     * @param chunkSize number of chromosomes bred and evaluated together
+     */
+    void initializeMappedPopulation(int size, const string &path, int chunkSize = 4096);
+    // Check if the population is kept in a memory-mapped file
+    bool isMappedPopulation() { return mappedPopulation.isOpen(); }
+
+    /**
+     * @brief Reproducible mode: the random numbers come from Philox4x32-10 streams keyed by (seed, generation, offspring index, draw index)
+     * instead of rand(), so a run gives the same result with any threads count, and one offspring can be regenerated on its own.
+     * @note Call it before initializePopulation. With the pipelined evaluation, the adaptive operators and the duplicate elimination
+     * see the offspring in another order, so such runs are reproducible among themselves but differ from the serial ones.
+     */
+    void setSeed(uint64_t seed);
+    // Go back to rand() and srand(time(0))
+    void clearSeed() { reproducible = false; }
+    // Check if the reproducible mode is enabled
+    bool isReproducible() { return reproducible; }
+
+    // Print the progress of solve() (on by default)
+    void setVerbose(bool verbose) { this->verbose = verbose; }
+    bool isVerbose() { return verbose; }
+
+    /**
+     * @brief Stop solve() from another thread by cancelling the token (now or at its deadline).
+     * The token and the max running time are checked between two evaluations, so solve() stops inside a generation
+     * and returns the best individual found so far.
+     * @note A batch given to the evaluator pool is finished first.
+     */
+    void setCancellationToken(shared_ptr<CancellationToken> cancellationToken) { this->cancellationToken = cancellationToken; }
+    shared_ptr<CancellationToken> getCancellationToken() { return cancellationToken; }
+    /**
+     * @brief The best chromosome found so far by the running (or last) solve(), safe to call from any thread without blocking it
+     *
+     * @param[out] version the number of improvements published so far, to poll only new ones
+     * @return false if nothing is found yet
+     * @note Not available in the multi-objective mode.
+     */
+    bool getBestSoFar(T &chromosome, double &fitness, uint64_t *version = nullptr) { return bestSoFar.read(chromosome, fitness, version); }
+    /**
+     * @brief Breed again the offspring %index% (counted from 0 after the elite) of %generation%, in reproducible mode.
+     * The population must be the parents of that generation, as returned by solve() with setMaxGeneration(generation).
+     * @note The adaptive operator selection must be off, its state is not replayed.
+     */
+    T regenerateOffspring(uint64_t generation, int index);
 
     // Solve the problem and return the best individual found
     Individual<T> solve();
+    /**
+     * @brief Advance the run by %generations% generations and keep its whole state (population, generation counter,
+     * termination conditions, restarts), so the calls can be interleaved with other work. The first call starts the run like solve(),
+     * solve() starts a new run from the current population.
+     * @return the best individual of the population
+     * @note Not available for a mapped population. The max running time counts from the start of the run.
+     */
+    Individual<T> step(uint64_t generations = 1);
+    // Check if a termination condition (or the cancellation) stopped the last step()
+    bool isTerminated() { return terminated; }
+    // Number of generations run by solve() or step() since the start of the run
+    uint64_t getGeneration() { return generation; }
+    /**
+     * @brief Warm start: evaluate the population again with a new fitness function, when the problem changes a little
+     * (a city is added or removed), then continue with step() or solve() from the adapted population.
+     * The chromosome fix function, if enabled, repairs every chromosome first.
+     * @note The memory of the old fitness (no improvement count, best so far, hall of fame, surrogate archive) is cleared.
+     * The population is scored in this process with the new function, even if an evaluator pool or an asynchronous fitness function is set:
+     * they still hold the old problem. Set the evaluator pool again, and update the delta, bounded and asynchronous fitness functions,
+     * to use the new problem in the next generations.
+     */
+    void rescorePopulation(function<double(T &)> fitnessFunction);
+    // Get the non-dominated individuals of the population (multi-objective mode)
+    vector<Individual<T>> getParetoFront();
+    // Check if the multi-objective mode is enabled
+    bool isMultiObjective() { return objectivesFunction != nullptr; }
     // Set elite percentage in the population
     void setElitePercentage(double ElitePercentage);
     // Biased random number generation for small numbers
@@ -94,6 +221,15 @@ public:
     void setCrossoverMethod(Crossover crossover) { this->crossover = crossover; }
     // Get the current crossover method, 'Uniform, OnePoint, TwoPoint, MixCrossover'
     Crossover getCrossoverMethod() { return crossover; }
+    /**
+     * @brief Gene Layout tells where the genes are in the chromosome structure: the one-point and two-point crossovers cut only between two genes
+     * and the swap mutation swaps whole genes of the same size, so multi-byte genes stay intact
+     * @note Without a layout the cut points are drawn over the bytes of the chromosome and the cut byte is split at a random bit.
+     *
+     * @param geneLayout at least 2 genes, in order, without overlap (an empty layout goes back to the byte cuts)
+     */
+    void setGeneLayout(const GeneLayout &geneLayout);
+    GeneLayout getGeneLayout() { return geneLayout; }
 
     /**
      * @brief Chromosome Fix Function is used to fix the chromosome when unwanted genes appear during the process of crossing over
@@ -107,6 +243,183 @@ public:
     // Check if the chromosome fix function is enabled
     bool isChromosomeFixFunctionEnabled() { return chromosomeFixFunctionStatus; }
 
+    /**
+     * @brief Batch Repair Function fixes the offspring by blocks on the thread pool instead of one by one on the breeding thread,
+     * it takes the place of the chromosome fix function while enabled
+     * @note Each block gets the scratch arena of its thread, reset before the call, so the repair needs no allocation (see Repair.h).
+     * The pipelined evaluation repairs each chunk as one block, before its evaluation, on the thread that evaluates it.
+     *
+     * @tparam T the type of the chromosome structure
+     * @param batchRepairFunction defines by user 'void repair(T* chromosomes, int count, ScratchArena& arena)'
+     * @param blockSize number of chromosomes per call
+     */
+    void setBatchRepairFunction(function<void(T *, int, ScratchArena &)> batchRepairFunction, int blockSize = 64);
+    // Enable / Disable the batch repair function
+    void setBatchRepairFunctionStatus(bool status);
+    // Check if the batch repair function is enabled
+    bool isBatchRepairFunctionEnabled() { return batchRepairFunctionStatus; }
+
+    /**
+     * @brief Delta Fitness Function rescores an offspring from its closest parent instead of evaluating it from scratch
+     * @note Offspring that the crossover and the mutation left identical to their closest parent take the parent's fitness without any evaluation.
+     *
+     * @tparam T the type of the chromosome structure
+     * @param deltaFitnessFunction defines by user 'double delta(T& chromosome, T& parentChromosome, double parentFitness, const vector<pair<int, int>>& modifiedRanges)',
+     * modifiedRanges holds sorted, disjoint [first, second) byte ranges of the chromosome that may differ from the parent:
+     * the one-point and two-point crossovers record the segments taken from the other parent and the mutated bytes,
+     * some of which can be equal to the parent's bytes. The other offspring (uniform crossover, fix function) are compared byte by byte.
+     */
+    void setDeltaFitnessFunction(function<double(T &, T &, double, const vector<pair<int, int>> &)> deltaFitnessFunction);
+    // Enable / Disable delta fitness function
+    void setDeltaFitnessFunctionStatus(bool status);
+    // Check if the delta fitness function is enabled
+    bool isDeltaFitnessFunctionEnabled() { return deltaFitnessFunctionStatus; }
+
+    /**
+     * @brief Bounded Fitness Function evaluates offspring against a cutoff, so it can stop early and return REJECTED_FITNESS
+     * as soon as the chromosome can not beat the cutoff. Rejected offspring get the worst possible fitness.
+     *
+     * @tparam T the type of the chromosome structure
+     * @param boundedFitnessFunction defines by user 'double fitness(T& chromosome, double cutoff)'
+     * @param cutoffPercentage the cutoff is the fitness of the last individual in the best cutoffPercentage% of the population,
+     * put -1 for the elite boundary (ElitePercentage), 100 for the worst kept individual
+     */
+    void setBoundedFitnessFunction(function<double(T &, double)> boundedFitnessFunction, double cutoffPercentage = -1);
+    // Enable / Disable bounded fitness function
+    void setBoundedFitnessFunctionStatus(bool status);
+    // Check if the bounded fitness function is enabled
+    bool isBoundedFitnessFunctionEnabled() { return boundedFitnessFunctionStatus; }
+
+    /**
+     * @brief Asynchronous Fitness Function for I/O-bound fitness (a job sent to a simulator, a server, ...).
+     * It starts the evaluation and returns, then done(fitness) is called from any thread when the result is ready.
+     * solve() keeps up to maxInFlight evaluations running from the calling thread, for the initial population and the offspring.
+     * @note The chromosome stays valid until done() is called. Every evaluation of the solver goes through it (restarts, kick out,
+     * duplicate elimination and the built-in local searches, one candidate at a time), except a user local search function
+     * and rescorePopulation, which call their own functions.
+     *
+     * @param asyncFitnessFunction defines by user 'void fitness(T& chromosome, function<void(double)> done)'
+     * @param maxInFlight max number of evaluations running at the same time
+     */
+    void setAsyncFitnessFunction(function<void(T &, function<void(double)>)> asyncFitnessFunction, int maxInFlight = 64);
+    // Enable / Disable asynchronous fitness function
+    void setAsyncFitnessFunctionStatus(bool status);
+    // Check if the asynchronous fitness function is enabled
+    bool isAsyncFitnessFunctionEnabled() { return asyncFitnessFunctionStatus; }
+
+    /**
+     * @brief Evaluate the initial population and the offspring in worker processes with the fitness function,
+     * so a fitness function that is not thread-safe, hangs or crashes can not stop solve().
+     * Every evaluation of the solver goes through the pool (restarts, kick out, duplicate elimination, surrogate screening and the
+     * built-in local searches, one candidate at a time), except a user local search function and rescorePopulation.
+     * @note Call it before starting any thread (setThreadsCount, setTrace, ...): a helper process is forked at once and forks every
+     * worker, so the fitness function and its data are copied into the workers as they are now.
+     * If no worker can be started, the chromosomes are evaluated in this process and the verbose output reports it.
+     *
+     * @param processesCount number of worker processes, put 0 to use all hardware threads
+     * @param timeout_ms max time of one evaluation in milliseconds, put 0 for no timeout
+     * @param penaltyFitness the fitness of a chromosome whose evaluation timed out or crashed,
+     * REJECTED_FITNESS gives it the worst possible fitness
+     * @param batchSize max chromosomes sent to a worker in one message
+     */
+    void setEvaluatorPool(int processesCount, double timeout_ms = 0, double penaltyFitness = REJECTED_FITNESS, int batchSize = 16);
+    // Share an evaluator pool, its chromosome size must be sizeof(T)
+    void setEvaluatorPool(shared_ptr<EvaluatorPool> evaluatorPool) { this->evaluatorPool = evaluatorPool; }
+    // Stop the worker processes and evaluate in this process
+    void disableEvaluatorPool() { evaluatorPool.reset(); }
+    shared_ptr<EvaluatorPool> getEvaluatorPool() { return evaluatorPool; }
+
+    /**
+     * @brief Surrogate Screening breeds candidatesFactor times more offspring than needed, ranks them with a cheap surrogate model
+     * and evaluates only the most promising ones with the fitness function.
+     * The default surrogate is the distance-weighted k-nearest-neighbour in Hamming space over an archive of evaluated chromosomes.
+     *
+     * @param candidatesFactor number of candidates bred per offspring slot
+     * @param neighbours k of the k-nearest-neighbour surrogate
+     * @param archiveSize max number of evaluated chromosomes kept in the archive, the oldest ones are replaced first
+     */
+    void setSurrogateScreening(int candidatesFactor, int neighbours = 5, int archiveSize = 10000);
+    /**
+     * @brief Replace the k-nearest-neighbour surrogate by a user model, used with setSurrogateScreening
+     *
+     * @param surrogateFunction defines by user 'double surrogate(T& chromosome)', an estimate of the fitness
+     */
+    void setSurrogateFunction(function<double(T &)> surrogateFunction);
+    // Enable / Disable surrogate screening
+    void setSurrogateScreeningStatus(bool status);
+    // Check if the surrogate screening is enabled
+    bool isSurrogateScreeningEnabled() { return surrogateScreeningStatus; }
+
+    /**
+     * @brief Restart Strategy (IPOP): when the best fitness does not improve for %stagnationGenerations% generations,
+     * keep the best individuals in a hall of fame and restart from a new random population, larger by %populationGrowth%.
+     * The restarts share the generations and time budget of solve(), which returns the best individual across all restarts.
+     * @note Not used in the multi-objective mode.
+     *
+     * @param stagnationGenerations generations without improvement before a restart
+     * @param populationGrowth the population size is multiplied by this factor at each restart, 1 to keep the same size
+     * @param maxRestarts put -1 for unlimited restarts
+     * @param hallOfFameSize number of the best distinct individuals kept across restarts
+     * @param maxPopulationSize the population stops growing at this size
+     */
+    void setRestartStrategy(uint64_t stagnationGenerations, double populationGrowth = 2.0, int maxRestarts = 9, int hallOfFameSize = 10, int maxPopulationSize = 100000);
+    // Disable the restart strategy
+    void disableRestartStrategy() { restartStrategyStatus = false; }
+    // Number of restarts done by the last solve()
+    int getRestartsCount() { return restartsCount; }
+    // The best distinct individuals found across restarts, best first
+    vector<Individual<T>> getHallOfFame() { return hallOfFame; }
+
+    /**
+     * @brief Memetic Local Search: improve the best new individuals of each generation with a hill climber, in parallel
+     * @note The fitness function must be thread-safe when the threads count is greater than 1. With an evaluator pool or an
+     * asynchronous fitness function, the individuals are improved one after the other and each candidate is evaluated by them.
+     *
+     * @param method 'BitFlip' first-improvement bit flips, or 'TwoOpt' first-improvement segment reversals for chromosomes of permuted bytes
+     * @param topCount number of the best new individuals (age 0) improved each generation
+     * @param evaluationsBudget max fitness evaluations per individual
+     * @param lamarckian true to write the improved chromosome back (Lamarckian), false to keep the chromosome and its fitness and rank it
+     * by the improved fitness (Baldwinian, see Individual::getLearnedFitness())
+     */
+    void setLocalSearch(LocalSearch method, int topCount, int evaluationsBudget = 100, bool lamarckian = true);
+    /**
+     * @brief Memetic Local Search with a user hill climber
+     *
+     * @param localSearchFunction defines by user 'double improve(T& chromosome, double fitness, int evaluationsBudget)',
+     * improves the chromosome in place and returns its new fitness
+     * @note It runs in this process and calls its own fitness, even with an evaluator pool.
+     */
+    void setLocalSearchFunction(function<double(T &, double, int)> localSearchFunction, int topCount, int evaluationsBudget = 100, bool lamarckian = true);
+    // Disable the local search
+    void disableLocalSearch() { localSearchStatus = false; }
+    // Check if the local search is enabled
+    bool isLocalSearchEnabled() { return localSearchStatus; }
+
+    /**
+     * @brief Set the number of threads used by the parallel stages (1 = serial), put 0 to use all hardware threads
+     *
+     * @param pinThreads pin the pool threads to CPUs spread evenly over the NUMA nodes, so the scratch memory of each thread
+     * (repair arenas, local search copies) is allocated on its own node, see getThreadPlacement()
+     */
+    void setThreadsCount(int threadsCount, bool pinThreads = false);
+    // The NUMA nodes and the CPU of each pool thread, empty when the threads are not pinned
+    string getThreadPlacement() { return threadPool ? threadPool->getPlacement() : string(); }
+    // Share a thread pool with other objects
+    void setThreadPool(shared_ptr<ThreadPool> threadPool) { this->threadPool = threadPool; }
+    int getThreadsCount() { return threadPool ? threadPool->size() : 1; }
+
+    /**
+     * @brief Pipelined Evaluation: breed the offspring in chunks and send each chunk through a bounded queue to the thread pool,
+     * which evaluates and sorts it while the next chunks are bred. The next generation is ranked by merging the sorted chunks.
+     * @note It needs a thread pool (setThreadsCount), and the fitness function must be thread-safe. Surrogate screening breeds serially.
+     *
+     * @param chunkSize number of offspring per chunk
+     * @param queueCapacity max chunks waiting for the pool, the breeding thread evaluates a chunk itself when the queue is full
+     */
+    void setPipelinedEvaluation(bool status, int chunkSize = 64, int queueCapacity = 4);
+    // Check if the pipelined evaluation is enabled
+    bool isPipelinedEvaluationEnabled() { return pipelinedEvaluationStatus; }
+
     // Set the Kick Out Age (dying of old age)
     void setKickOutAge(int kickOutAge, bool exceptBestOne = true)
     {
@@ -114,6 +427,106 @@ public:
         kickOutExceptBest = exceptBestOne;
     }
 
+    // Replace duplicate chromosomes in each new generation with mutated copies (or new random chromosomes)
+    void setDuplicateElimination(bool status) { duplicateEliminationStatus = status; }
+    // Check if the duplicate elimination is enabled
+    bool isDuplicateEliminationEnabled() { return duplicateEliminationStatus; }
+
+    /**
+     * @brief Niching keeps several peaks of a multimodal problem: the parents and the elite are chosen by a niche fitness,
+     * the fitness shared with the neighbours (FitnessSharing) or cleared outside the best of each niche (Clearing).
+     * The neighbours within the radius are found by bit-sampling locality-sensitive hashing, close to linear time instead of O(n^2).
+     * @note The fitness of the individuals is not changed, solve() still returns the best one, use getNiches() for the best of each niche.
+     * Not used in the multi-objective mode and the mapped mode.
+     *
+     * @param method 'FitnessSharing' or 'Clearing'
+     * @param radius niche radius, in bits (Hamming distance)
+     * @param capacity individuals that keep their fitness in each niche (Clearing)
+     * @param alpha shape of the sharing function 1 - (d / radius)^alpha (FitnessSharing)
+     * @param tablesCount hash tables of the neighbour search, more tables miss less neighbours
+     */
+    void setNiching(Niching method, int radius, int capacity = 1, double alpha = 1, int tablesCount = 8);
+    // Enable / Disable the niching
+    void setNichingStatus(bool status);
+    // Check if the niching is enabled
+    bool isNichingEnabled() { return nichingStatus; }
+    // The best individual of each niche of the population (no two of them within the niche radius), best first
+    vector<Individual<T>> getNiches();
+
+    /**
+     * @brief Adaptive Operator Selection credits each operator with the fitness improvement of its offspring over their best parent,
+     * and shifts the MixCrossover / MixSelection probabilities toward the operators that produce improving offspring.
+     * @note It only changes the Mix methods, and it is not used in the multi-objective mode.
+     *
+     * @param status true to enable, false to go back to the fixed probabilities
+     * @param adaptation 'ProbabilityMatching' or 'MultiArmedBandit'
+     */
+    void setAdaptiveOperatorSelection(bool status, Adaptation adaptation = ProbabilityMatching);
+    // Check if the adaptive operator selection is enabled
+    bool isAdaptiveOperatorSelectionEnabled() { return adaptiveOperatorSelectionStatus; }
+    // Statistics of the crossover operators, indexed by 'Uniform, OnePoint, TwoPoint'
+    vector<OperatorStats> getCrossoverStats() { return crossoverSelector.getStats(); }
+    // Statistics of the parent selection operators, indexed by 'Fast, RouletteWheel'
+    vector<OperatorStats> getSelectionStats() { return selectionSelector.getStats(); }
+
+    /**
+     * @brief Population diversity, the mean pairwise Hamming distance divided by the chromosome size in bits
+     * @note Time complexity: O(s m / 64), where s is the number of sampled pairs and m is the chromosome size in bits
+     *
+     * @param samples number of random pairs, put -1 to use all pairs
+     * @return diversity in [0, 1], 0 when all chromosomes are the same
+     */
+    double getDiversity(int samples = 1000);
+    /**
+     * @brief Keep the fitness mean, standard deviation and allele counts of the population up to date while solving,
+     * updated as each individual is evaluated (on anyway when the min diversity, the fitness band or the converged alleles condition is set)
+     * @note Not available in the multi-objective mode.
+     */
+    void setPopulationStatistics(bool status) { populationStatisticsStatus = status; }
+    // The statistics of the current population, see setPopulationStatistics
+    PopulationStatistics &getPopulationStatistics() { return populationStatistics; }
+    // A copy of the current population, ranked after step()
+    vector<Individual<T>> getPopulation() { return population; }
+    // Number of fitness evaluations so far (the custom local search function is not counted)
+    uint64_t getEvaluationsCount() { return evaluationsCount.load(memory_order_relaxed); }
+
+    /**
+     * @brief Trace every generation of solve() and step() into %path% (see GenerationRecord): timestamps, best, mean and worst fitness,
+     * diversity, evaluations and phase times. The records go through a preallocated lock-free ring buffer, written by a background thread.
+     * @note The population statistics are kept while tracing. Mapped populations are not traced.
+     * @return false if the file can not be created
+     */
+    bool setTrace(const string &path, TraceFormat format = TraceBinary, int capacity = 4096)
+    {
+        traceWriter.reset(); // close the old trace first, it may be the same file
+        traceWriter = make_shared<TraceWriter>(path, format, capacity);
+        if (!traceWriter->isOpen())
+            traceWriter.reset();
+        return traceWriter != nullptr;
+    }
+    void setTrace(shared_ptr<TraceWriter> traceWriter) { this->traceWriter = traceWriter; }
+    shared_ptr<TraceWriter> getTrace() { return traceWriter; }
+    // Stop tracing, the remaining records are written when the last owner of the trace releases it
+    void disableTrace() { traceWriter.reset(); }
+    /**
+     * @brief Publish the statistics of every generation of solve() and step() into the POSIX shared-memory segment %name% (like "/ga_stats"):
+     * generation, best, mean, diversity, evaluations per second, phase times and the best chromosome so far (see StatsPage).
+     * Watch it from another process with the ga_monitor tool. The solver never waits for the monitors, publishing is a few stores per generation.
+     * @note The population statistics are kept while publishing. Mapped populations are not published. The segment is removed with the page.
+     * @return false if the segment can not be created
+     */
+    bool setStatsPage(const string &name)
+    {
+        statsPage = make_shared<StatsPage>();
+        if (!statsPage->create(name, sizeof(T)))
+            statsPage.reset();
+        return statsPage != nullptr;
+    }
+    shared_ptr<StatsPage> getStatsPage() { return statsPage; }
+    void disableStatsPage() { statsPage.reset(); }
+    // Frequency of the allele 1 at each bit of the chromosome over the population
+    vector<double> getAlleleFrequencies();
+
     // Terminate the solving process when one of the conditions occur
     TerminationConditions terminationConditions;
 
@@ -128,11 +541,48 @@ private:
     bool maximizeFitness;
     int getPercentageSize(double Percentage);
 
-    // Cross over
-    inline Individual<T> mate(Individual<T> &parent1, Individual<T> &parent2);
-    Individual<T> uniform(Individual<T> &parent1, Individual<T> &parent2);
-    Individual<T> onePoint(Individual<T> &parent1, Individual<T> &parent2);
-    Individual<T> twoPoint(Individual<T> &parent1, Individual<T> &parent2);
+    // The byte ranges of an offspring that may differ from each parent, recorded by mate() for the delta fitness function
+    struct OffspringChanges
+    {
+        bool known; // false when only comparing the bytes tells (uniform crossover, fix function)
+        int count[2];
+        pair<int, int> ranges[2][4]; // [parent][range], two crossover segments and two mutated genes at most
+
+        void clear()
+        {
+            known = true;
+            count[0] = count[1] = 0;
+        }
+        void add(int parent, int first, int last)
+        {
+            if (first < last)
+                ranges[parent][count[parent]++] = make_pair(first, last);
+        }
+        // A mutation changes the offspring whichever parent it is compared to
+        void addBoth(int first, int last)
+        {
+            add(0, first, last);
+            add(1, first, last);
+        }
+    };
+
+    // Cross over, return the crossover method used, and record the changed bytes in %changes% if not nullptr
+    inline Crossover mate(Individual<T> &parent1, Individual<T> &parent2, T &newChromosome, OffspringChanges *changes = nullptr);
+    inline Crossover mate(byte *chromosome1, byte *chromosome2, T &newChromosome, OffspringChanges *changes = nullptr);
+    void uniform(byte *chromosome1, byte *chromosome2, T &newChromosome);
+    void onePoint(byte *chromosome1, byte *chromosome2, T &newChromosome, OffspringChanges *changes);
+    void twoPoint(byte *chromosome1, byte *chromosome2, T &newChromosome, OffspringChanges *changes);
+    // The swap or flip bit mutation of the one-point and two-point crossovers
+    void mutateOffspring(byte *p, OffspringChanges *changes);
+
+    /// Gene Layout
+    GeneLayout geneLayout;
+    vector<int> cutPoints; // the offsets of the genes after the first one
+    // A cut point, the offspring takes the bytes before it from one parent and the rest from the other
+    int drawCutPoint() { return cutPoints.empty() ? RANDOM((int)sizeof(T)) : cutPoints[RANDOM((int)cutPoints.size())]; }
+
+    // Compute the fitness of a new offspring, from scratch or from its closest parent, with the changes recorded by mate() if known
+    Individual<T> evaluateOffspring(T &newChromosome, Individual<T> &parent1, Individual<T> &parent2, const OffspringChanges *changes = nullptr);
 
     Crossover crossover;
     Selection selection;
@@ -161,10 +611,276 @@ private:
      * @param[out] p2 parent2 index
      */
     void fastSelection(int &p1, int &p2);
+    // Select parents with the current selection method, return the selection method used
+    Selection selectParents(int &p1, int &p2);
+    // Breed %count% offspring into the new generation
+    void breedOffspring(int count, vector<Individual<T>> &newGeneration);
 
     /// Fix Chromosome
     bool chromosomeFixFunctionStatus;
     function<void(T &)> chromosomeFixFunction;
+    // Fix one chromosome with the batch repair function or the chromosome fix function
+    void repairChromosome(T &chromosome);
+
+    /// Batch Repair
+    bool batchRepairFunctionStatus;
+    function<void(T *, int, ScratchArena &)> batchRepairFunction;
+    int repairBlockSize;
+    static const uint32_t repairDraws = 0x80000000; // the stream of a block is the one of its first offspring + repairDraws
+    // Repair %count% chromosomes by blocks on the thread pool, %firstIndex% is the offspring index of the first one
+    void repairBlocks(T *chromosomes, int count, int firstIndex = 0);
+    // Repair one block on the calling thread
+    void repairBlock(T *chromosomes, int count, int firstIndex);
+    // Repair the member %chromosome% of the items as one block
+    template <class Item>
+    void repairItems(vector<Item> &items, T Item::*chromosome, int firstIndex);
+    // Breed, repair by blocks then evaluate %count% offspring, the serial breeding with a batch repair function
+    void repairedOffspring(int count, vector<Individual<T>> &newGeneration);
+
+    /// Delta Fitness
+    bool deltaFitnessFunctionStatus;
+    function<double(T &, T &, double, const vector<pair<int, int>> &)> deltaFitnessFunction;
+    /**
+     * @brief Collect the byte ranges where the chromosome differs from the parent
+     * @note Time complexity: O(m), where m is the size of the chromosome in bytes
+     *
+     * @param[out] modifiedRanges [first, second) byte ranges
+     * @return the number of modified bytes
+     */
+    int getModifiedRanges(byte *parent, byte *chromosome, vector<pair<int, int>> &modifiedRanges);
+    // The sorted, merged ranges that mate() recorded for %parent% (0 or 1), O(1); return the number of bytes they cover
+    int recordedRanges(const OffspringChanges &changes, int parent, vector<pair<int, int>> &modifiedRanges);
+
+    /// Bounded Fitness
+    bool boundedFitnessFunctionStatus;
+    function<double(T &, double)> boundedFitnessFunction;
+    double cutoffPercentage;
+    double cutoff;
+    // Update the cutoff from the sorted population
+    void prepareCutoff();
+    // The fitness that sorts after every other fitness
+    double worstFitness() { return maximizeFitness ? -HUGE_VAL : HUGE_VAL; }
+
+    /// Asynchronous Fitness
+    bool asyncFitnessFunctionStatus;
+    function<void(T &, function<void(double)>)> asyncFitnessFunction;
+    int maxInFlight;
+    // Evaluate the chromosomes with the asynchronous fitness function and wait for all of them
+    void evaluateAsync(vector<T> &chromosomes, vector<double> &fitness);
+
+    /// Evaluator Pool
+    shared_ptr<EvaluatorPool> evaluatorPool;
+
+    // Chromosomes are evaluated in batches by the evaluator pool or the asynchronous fitness function
+    bool isBatchEvaluation() { return (evaluatorPool || asyncFitnessFunctionStatus) && !isMultiObjective(); }
+    // Build the individuals of a batch of chromosomes, the NaN fitness rejects the individual
+    void evaluateBatch(vector<T> &chromosomes, vector<Individual<T>> &individuals);
+    // Breed %count% offspring into the new generation, evaluated as one batch
+    void batchOffspring(int count, vector<Individual<T>> &newGeneration);
+    // Compute the fitness of the chromosomes with the batch evaluation or the thread pool, NaN for rejected chromosomes
+    void evaluateChromosomes(vector<T> &chromosomes, vector<double> &fitness);
+
+    /// Mapped Population
+    MappedPopulation mappedPopulation;
+    int mappedChunkSize;
+    vector<double> mappedFitness, nextFitness;
+    vector<uint64_t> mappedAge, nextAge;
+    // solve() for a population kept in a memory-mapped file
+    Individual<T> solveMapped();
+    Individual<T> getMappedIndividual(int index);
+
+    bool verbose;
+
+    /// Cancellation
+    shared_ptr<CancellationToken> cancellationToken;
+    BestSoFar<T> bestSoFar;
+    // The token is cancelled or the max running time is reached, thread-safe
+    bool isStopping() { return (cancellationToken && cancellationToken->isCancelled()) || terminationConditions.checkTimeCondition(); }
+    void publish(Individual<T> &individual)
+    {
+        if (!individual.isRejected() && !isMultiObjective())
+            bestSoFar.offer(*(T *)individual.getChromosomePointer(), individual.getFitness());
+    }
+    // The return value of a stopped solve(): the best of the population and of the published chromosomes
+    Individual<T> stoppedResult();
+
+    /// Population Statistics
+    bool populationStatisticsStatus, trackingStatistics;
+    PopulationStatistics populationStatistics, nextStatistics; // of the population, of the new generation
+    bool isTrackingStatistics()
+    {
+        return (populationStatisticsStatus || terminationConditions.enableDiversity || terminationConditions.enableFitnessBand || terminationConditions.enableAlleles ||
+                traceWriter || statsPage) &&
+               !isMultiObjective();
+    }
+    void record(PopulationStatistics &statistics, Individual<T> &individual)
+    {
+        if (trackingStatistics)
+            statistics.add(individual.getChromosomePointer(), individual.getFitness());
+    }
+    // Count the whole population, when the statistics are out of date (new run, restart, warm start)
+    void computeStatistics();
+
+    /// Incremental solving
+    bool runStarted, terminated, stopped;
+    uint64_t generation;
+    // Reset the state of a run, shared by solve() and the first step()
+    void startRun();
+    // Run one generation, return false when a termination condition is reached
+    bool runGeneration();
+    bool runGeneration(GenerationRecord *trace);
+
+    /// Trace
+    shared_ptr<TraceWriter> traceWriter;
+    shared_ptr<StatsPage> statsPage;
+    StatsSnapshot statsSnapshot; // the last published
+    uint64_t statsEvaluations;   // evaluations at the start of the generation
+    // The time base of the records: the trace, or the stats page without trace
+    int64_t traceNow_ns() { return traceWriter ? traceWriter->now_ns() : statsPage->now_ns(); }
+    // Write the record of the generation to the stats page
+    void publishStats(GenerationRecord &record, bool running);
+    atomic<uint64_t> evaluationsCount;
+    void countEvaluations(uint64_t count) { evaluationsCount.fetch_add(count, memory_order_relaxed); }
+    // Add the time since %t% to the %phase% of the record, and restart %t%
+    void tracePhase(GenerationRecord *trace, int64_t GenerationRecord::*phase, int64_t &t)
+    {
+        if (trace == nullptr)
+            return;
+        int64_t now = traceNow_ns();
+        trace->*phase += now - t;
+        t = now;
+    }
+    // Print why the run is stopped, return false
+    bool stopRun();
+
+    /// Niching
+    bool nichingStatus;
+    Niching nichingMethod;
+    int nicheRadius, nicheCapacity, nicheTables;
+    double nicheAlpha;
+    HammingIndex nicheIndex;
+    vector<int> nicheOrder;      // the population indices by niche fitness, best first, empty out of the breeding
+    vector<double> nicheFitness; // the niche fitness of population[nicheOrder[i]]
+    // Rank the sorted population by niche fitness
+    void computeNiches();
+    // Split the sorted population into the first %capacity% individuals of each niche and the cleared ones
+    void clearNiches(int capacity, vector<int> &kept, vector<int> &cleared);
+    void resetNicheIndex();
+    // The individual of rank %rank% for the selection and the elite
+    Individual<T> &ranked(int rank) { return nicheOrder.empty() ? population[rank] : population[nicheOrder[rank]]; }
+
+    /// Reproducible mode
+    bool reproducible;
+    uint64_t seed;
+    uint32_t currentGeneration;
+    static const uint32_t initialGeneration = 0xFFFFFFFF; // the streams of the initial population
+    static const uint32_t generationDraws = 0xFFFFFFFF;   // the stream of the draws that belong to no offspring
+    // The stream of offspring %index% of the current generation, or the current stream out of the reproducible mode
+    RandomStream *randomStream(RandomStream &stream, uint32_t index)
+    {
+        if (!reproducible)
+            return currentRandomStream();
+        stream.reset(seed, currentGeneration, index);
+        return &stream;
+    }
+
+    /// Multi-objective
+    function<vector<double>(T &)> objectivesFunction;
+    vector<bool> maximizeObjectives;
+    int frontsCount;
+    // Compute the objectives of the individuals that have none yet
+    void evaluateObjectives(vector<Individual<T>> &individuals);
+    /**
+     * @brief Rank the individuals by non-dominated sorting and crowding distance, then keep the best %size% of them
+     * @note The fitness becomes 2 * (frontsCount - front) + crowding / (1 + crowding), so higher is better
+     */
+    void selectNonDominated(vector<Individual<T>> &individuals, int size);
+
+    /// Duplicate Elimination
+    bool duplicateEliminationStatus;
+    // Replace the chromosomes that appear earlier in %individuals%, the first copy is kept
+    // %statistics% (if any) follows the replaced individuals
+    void eliminateDuplicates(vector<Individual<T>> &individuals, PopulationStatistics *statistics = nullptr);
+    uint64_t hashChromosome(byte *chromosome);
+    // Copy the chromosomes into 64-bit words, %words% words per chromosome
+    void packPopulation(vector<uint64_t> &packed, int &words);
+
+    /// Adaptive Operator Selection
+    bool adaptiveOperatorSelectionStatus;
+    OperatorSelector crossoverSelector, selectionSelector;
+    // Credit the operators that produced %offspring%
+    void creditOperators(Selection selectionUsed, Crossover crossoverUsed, Individual<T> &offspring, Individual<T> &parent1, Individual<T> &parent2);
+
+    /// Restart Strategy
+    bool restartStrategyStatus;
+    uint64_t stagnationGenerations, stagnation;
+    double populationGrowth;
+    int maxRestarts, restartsCount, hallOfFameSize, maxPopulationSize;
+    vector<Individual<T>> hallOfFame;
+    double restartBestFitness;
+    bool isBetter(Individual<T> &a, Individual<T> &b) { return maximizeFitness ? a.getFitness() > b.getFitness() : a.getFitness() < b.getFitness(); }
+    void addToHallOfFame(Individual<T> &individual);
+    // Check the stagnation of the sorted population and restart it when needed, return true after a restart
+    bool checkRestart();
+    // The best individual found by solve(), across restarts
+    Individual<T> &getBestIndividual();
+    // The individual of the sorted population with the best fitness, not always the first after a Baldwinian local search
+    Individual<T> &getPopulationBest();
+
+    /// Parallel stages
+    shared_ptr<ThreadPool> threadPool;
+    // Run task(i) for every i in [0, count[ on the thread pool, or serially without a pool
+    void parallelFor(int count, function<void(int)> task);
+
+    /// Local Search
+    bool localSearchStatus;
+    LocalSearch localSearchMethod;
+    function<double(T &, double, int)> localSearchFunction;
+    int localSearchTopCount, localSearchBudget;
+    bool lamarckian;
+    // Improve the best new individuals of the sorted population, return true if any fitness changed
+    bool applyLocalSearch();
+    double bitFlipSearch(T &chromosome, double fitness, int evaluationsBudget, uint32_t seed);
+    double twoOptSearch(T &chromosome, double fitness, int evaluationsBudget, uint32_t seed);
+    // Evaluate a candidate of the built-in searches, by the evaluator pool or the asynchronous fitness function if set
+    double evaluateCandidate(T &candidate);
+    // Sort the population, best first
+    void sortPopulation();
+    // The order of sortPopulation(): best fitness first, then the oldest
+    bool comesBefore(const Individual<T> &a, const Individual<T> &b)
+    {
+        if (a.getLearnedFitness() != b.getLearnedFitness())
+            return maximizeFitness ? a.getLearnedFitness() > b.getLearnedFitness() : a.getLearnedFitness() < b.getLearnedFitness();
+        if (a.getAge() != b.getAge())
+            return a.getAge() > b.getAge();
+        // A total order, so sorting and merging give the same population (reproducible mode)
+        return reproducible && memcmp(const_cast<Individual<T> &>(a).getChromosomePointer(), const_cast<Individual<T> &>(b).getChromosomePointer(), sizeof(T)) < 0;
+    }
+
+    /// Pipelined Evaluation
+    bool pipelinedEvaluationStatus;
+    int chunkSize, queueCapacity;
+    bool populationSorted; // the population is already in the order of sortPopulation()
+    /**
+     * @brief Breed %count% offspring into the new generation, evaluate them in chunks on the thread pool,
+     * then merge the sorted chunks with the new generation
+     */
+    void pipelineOffspring(int count, vector<Individual<T>> &newGeneration);
+
+    /// Surrogate Screening
+    bool surrogateScreeningStatus;
+    int candidatesFactor, surrogateNeighbours, archiveSize, archiveNext;
+    function<double(T &)> surrogateFunction;
+    HammingIndex archive;
+    vector<double> archiveFitness;
+    vector<pair<int, int>> neighbours;
+    void addToArchive(Individual<T> &individual);
+    double surrogateScore(T &chromosome);
+    /**
+     * @brief Breed %count% offspring into the new generation using surrogate screening
+     * @note Fitness evaluations: count, surrogate evaluations: count * candidatesFactor
+     */
+    void screenOffspring(int count, vector<Individual<T>> &newGeneration);
 };
 
 template <class T>
@@ -180,6 +896,49 @@ GeneticAlgorithm<T>::GeneticAlgorithm(function<double(T &)> fitnessFunction, boo
     terminationConditions.setMaxGeneration(maxGeneration);
     kickOutAge = -1;
     chromosomeFixFunctionStatus = false;
+    batchRepairFunctionStatus = false;
+    repairBlockSize = 64;
+    deltaFitnessFunctionStatus = false;
+    boundedFitnessFunctionStatus = false;
+    surrogateScreeningStatus = false;
+    candidatesFactor = 0;
+    frontsCount = 0;
+    duplicateEliminationStatus = false;
+    setAdaptiveOperatorSelection(false);
+    restartStrategyStatus = false;
+    restartsCount = 0;
+    localSearchStatus = false;
+    pipelinedEvaluationStatus = false;
+    populationSorted = false;
+    asyncFitnessFunctionStatus = false;
+    maxInFlight = 0;
+    mappedChunkSize = 0;
+    nichingStatus = false;
+    nichingMethod = Clearing;
+    nicheRadius = nicheCapacity = nicheTables = 0;
+    nicheAlpha = 1;
+    reproducible = false;
+    seed = 0;
+    currentGeneration = 0;
+    verbose = true;
+    runStarted = terminated = stopped = false;
+    populationStatisticsStatus = trackingStatistics = false;
+    evaluationsCount = 0;
+    statsEvaluations = 0;
+    memset(&statsSnapshot, 0, sizeof(statsSnapshot));
+    generation = 0;
+}
+
+template <class T>
+GeneticAlgorithm<T>::GeneticAlgorithm(function<vector<double>(T &)> objectivesFunction, vector<bool> maximizeObjectives, uint64_t maxGeneration, double MutationPercentage, Selection selection, Crossover crossover)
+    : GeneticAlgorithm([](T &) -> double
+                       { return 0; },
+                       true, maxGeneration, MutationPercentage, 15.0, selection, crossover)
+{
+    assert((objectivesFunction != nullptr) && "No objectives function");
+    assert((!maximizeObjectives.empty()) && "No objectives");
+    this->objectivesFunction = objectivesFunction;
+    this->maximizeObjectives = maximizeObjectives;
 }
 
 template <class T>
@@ -188,17 +947,17 @@ GeneticAlgorithm<T>::~GeneticAlgorithm<T>()
 }
 
 template <class T>
-T GeneticAlgorithm<T>::generateRandomChromosome()
+T GeneticAlgorithm<T>::generateRandomChromosome(bool repair)
 {
     const int sz = sizeof(T);
     T newChromosome;
     byte *p = (byte *)&newChromosome;
 
     for (int i = 0; i < sz; i++)
-        p[i] = rand() % 256;
+        p[i] = RANDOM(256);
 
-    if (chromosomeFixFunctionStatus)
-        chromosomeFixFunction(newChromosome);
+    if (repair)
+        repairChromosome(newChromosome);
 
     return newChromosome;
 }
@@ -222,7 +981,9 @@ template <class T>
 void GeneticAlgorithm<T>::initializePopulation(vector<Individual<T>> &population)
 {
     this->population = population;
-    srand((unsigned int)time(0));
+    mappedPopulation.close();
+    if (!reproducible)
+        srand((unsigned int)time(0));
     assert((population.size() > 10) && "Population size must be greater than 10.");
     populationSize = population.size();
 }
@@ -231,25 +992,36 @@ template <class T>
 void GeneticAlgorithm<T>::initializePopulation(int size)
 {
     population.clear();
-    srand((unsigned int)time(0));
+    mappedPopulation.close();
+    if (!reproducible)
+        srand((unsigned int)time(0));
     assert((size > 10) && "Population size must be greater than 10.");
+    currentGeneration = initialGeneration;
+    vector<T> chromosomes;
     for (int i = 0; i < size; i++)
     {
-        T chromosome = generateRandomChromosome();
-        population.push_back(Individual<T>(fitnessFunction, chromosome));
+        RandomStream stream;
+        RandomScope scope(randomStream(stream, i));
+        chromosomes.push_back(generateRandomChromosome(!batchRepairFunctionStatus));
+    }
+    if (batchRepairFunctionStatus)
+        repairBlocks(chromosomes.data(), size);
+
+    if (isBatchEvaluation())
+        evaluateBatch(chromosomes, population);
+    else
+    {
+        countEvaluations(size);
+        for (int i = 0; i < size; i++)
+            population.push_back(Individual<T>(fitnessFunction, chromosomes[i]));
     }
 
     populationSize = (int)population.size();
 }
 
 template <class T>
-Individual<T> GeneticAlgorithm<T>::uniform(Individual<T> &parent1, Individual<T> &parent2)
+void GeneticAlgorithm<T>::uniform(byte *chromosome1, byte *chromosome2, T &newChromosome)
 {
-    byte *chromosome1 = parent1.getChromosomePointer();
-    byte *chromosome2 = parent2.getChromosomePointer();
-
-    T newChromosome;
-
     byte *p = (byte *)&newChromosome;
     const int sz = sizeof(T);
     for (int i = 0; i < sz; i++)
@@ -267,27 +1039,25 @@ Individual<T> GeneticAlgorithm<T>::uniform(Individual<T> &parent1, Individual<T>
         }
         p[i] = b;
     }
-    if (chromosomeFixFunctionStatus)
-        chromosomeFixFunction(newChromosome);
-    return Individual<T>(fitnessFunction, newChromosome);
 }
 
 template <class T>
-Individual<T> GeneticAlgorithm<T>::onePoint(Individual<T> &parent1, Individual<T> &parent2)
+void GeneticAlgorithm<T>::onePoint(byte *chromosome1, byte *chromosome2, T &newChromosome, OffspringChanges *changes)
 {
-    byte *chromosome1 = parent1.getChromosomePointer();
-    byte *chromosome2 = parent2.getChromosomePointer();
-
-    T newChromosome;
-
     byte *p = (byte *)&newChromosome;
     const int sz = sizeof(T);
+    const bool splitByte = cutPoints.empty(); // with a gene layout the cut falls between two genes
 
-    int crossPoint = RANDOM(populationSize);
+    int crossPoint = drawCutPoint();
+    if (changes)
+    {
+        changes->add(0, crossPoint, sz);
+        changes->add(1, 0, crossPoint + (splitByte ? 1 : 0));
+    }
     for (int i = 0; i < sz; i++)
         if (i < crossPoint)
             p[i] = chromosome1[i];
-        else if (i > crossPoint)
+        else if (i > crossPoint || !splitByte)
             p[i] = chromosome2[i];
         else
         {
@@ -301,51 +1071,33 @@ Individual<T> GeneticAlgorithm<T>::onePoint(Individual<T> &parent1, Individual<T
             p[i] = b;
         }
 
-    double r = RANDOM(10000) / 100.0;
-    if (r < MutationPercentage / 2.0)
-    {
-        // Swap Mutation
-        int r1 = RANDOM(sz);
-        int r2 = RANDOM(sz);
-
-        byte tmp = p[r1];
-        p[r1] = p[r2];
-        p[r2] = tmp;
-    }
-    else if (r < MutationPercentage)
-    {
-        /// Flip bit Mutation
-        int r1 = RANDOM(sz);
-        int r2 = RANDOM(8);
-        FLIP_BIT(p[r1], r2);
-    }
-
-    if (chromosomeFixFunctionStatus)
-        chromosomeFixFunction(newChromosome);
-    return Individual<T>(fitnessFunction, newChromosome);
+    mutateOffspring(p, changes);
 }
 
 template <class T>
-Individual<T> GeneticAlgorithm<T>::twoPoint(Individual<T> &parent1, Individual<T> &parent2)
+void GeneticAlgorithm<T>::twoPoint(byte *chromosome1, byte *chromosome2, T &newChromosome, OffspringChanges *changes)
 {
-    byte *chromosome1 = parent1.getChromosomePointer();
-    byte *chromosome2 = parent2.getChromosomePointer();
-
-    T newChromosome;
-
     byte *p = (byte *)&newChromosome;
     const int sz = sizeof(T);
+    const bool splitByte = cutPoints.empty();
 
-    int crossPoint1 = RANDOM(populationSize);
-    int crossPoint2 = RANDOM(populationSize);
+    int crossPoint1 = drawCutPoint();
+    int crossPoint2 = drawCutPoint();
 
     if (crossPoint1 > crossPoint2)
         swap(crossPoint1, crossPoint2);
+    if (changes)
+    {
+        const int split = splitByte ? 1 : 0;
+        changes->add(0, crossPoint1, crossPoint2 + split);
+        changes->add(1, 0, crossPoint1 + split);
+        changes->add(1, crossPoint2, sz);
+    }
 
     for (int i = 0; i < sz; i++)
-        if (i < crossPoint1 || crossPoint2 < i)
+        if (i < crossPoint1 || crossPoint2 < i || (!splitByte && crossPoint2 == i))
             p[i] = chromosome1[i];
-        else if (crossPoint1 < i && i < crossPoint2)
+        else if ((crossPoint1 < i && i < crossPoint2) || !splitByte)
             p[i] = chromosome2[i];
         else
         {
@@ -359,16 +1111,42 @@ Individual<T> GeneticAlgorithm<T>::twoPoint(Individual<T> &parent1, Individual<T
             p[i] = b;
         }
 
+    mutateOffspring(p, changes);
+}
+
+template <class T>
+void GeneticAlgorithm<T>::mutateOffspring(byte *p, OffspringChanges *changes)
+{
+    const int sz = sizeof(T);
     double r = RANDOM(10000) / 100.0;
     if (r < MutationPercentage / 2.0)
     {
         // Swap Mutation
-        int r1 = RANDOM(sz);
-        int r2 = RANDOM(sz);
-
-        byte tmp = p[r1];
-        p[r1] = p[r2];
-        p[r2] = tmp;
+        if (geneLayout.empty())
+        {
+            int r1 = RANDOM(sz);
+            int r2 = RANDOM(sz);
+            swap(p[r1], p[r2]);
+            if (changes)
+            {
+                changes->addBoth(r1, r1 + 1);
+                changes->addBoth(r2, r2 + 1);
+            }
+        }
+        else
+        {
+            int g1 = RANDOM(geneLayout.size());
+            int g2 = RANDOM(geneLayout.size());
+            if (geneLayout.getSize(g1) == geneLayout.getSize(g2))
+            {
+                swap_ranges(p + geneLayout.getOffset(g1), p + geneLayout.getOffset(g1) + geneLayout.getSize(g1), p + geneLayout.getOffset(g2));
+                if (changes)
+                {
+                    changes->addBoth(geneLayout.getOffset(g1), geneLayout.getOffset(g1) + geneLayout.getSize(g1));
+                    changes->addBoth(geneLayout.getOffset(g2), geneLayout.getOffset(g2) + geneLayout.getSize(g2));
+                }
+            }
+        }
     }
     else if (r < MutationPercentage)
     {
@@ -376,74 +1154,423 @@ Individual<T> GeneticAlgorithm<T>::twoPoint(Individual<T> &parent1, Individual<T
         int r1 = RANDOM(sz);
         int r2 = RANDOM(8);
         FLIP_BIT(p[r1], r2);
+        if (changes)
+            changes->addBoth(r1, r1 + 1);
     }
+}
 
-    if (chromosomeFixFunctionStatus)
-        chromosomeFixFunction(newChromosome);
-    return Individual<T>(fitnessFunction, newChromosome);
+template <class T>
+void GeneticAlgorithm<T>::setGeneLayout(const GeneLayout &geneLayout)
+{
+    assert((geneLayout.empty() || (geneLayout.size() >= 2 && geneLayout.isValid(sizeof(T)))) && "Invalid gene layout");
+    this->geneLayout = geneLayout;
+    cutPoints.clear();
+    for (int g = 1; g < geneLayout.size(); g++)
+        cutPoints.push_back(geneLayout.getOffset(g));
+}
+
+template <class T>
+inline Crossover GeneticAlgorithm<T>::mate(Individual<T> &parent1, Individual<T> &parent2, T &newChromosome, OffspringChanges *changes)
+{
+    return mate(parent1.getChromosomePointer(), parent2.getChromosomePointer(), newChromosome, changes);
 }
 
 template <class T>
-inline Individual<T> GeneticAlgorithm<T>::mate(Individual<T> &parent1, Individual<T> &parent2)
+inline Crossover GeneticAlgorithm<T>::mate(byte *chromosome1, byte *chromosome2, T &newChromosome, OffspringChanges *changes)
 {
-    switch (crossover)
+    Crossover method = crossover;
+    if (method == MixCrossover)
+    {
+        if (adaptiveOperatorSelectionStatus)
+            method = (Crossover)crossoverSelector.select(RANDOM(10000) / 10000.0);
+        else
+        {
+            int r = RANDOM(100);
+            method = (r < 40) ? Uniform : (r < 65) ? OnePoint
+                                                   : TwoPoint;
+        }
+    }
+
+    if (changes)
+        changes->clear();
+    switch (method)
     {
     case Uniform:
-        return uniform(parent1, parent2);
+        uniform(chromosome1, chromosome2, newChromosome);
+        if (changes)
+            changes->known = false; // every byte mixes both parents
         break;
     case OnePoint:
-        return onePoint(parent1, parent2);
+        onePoint(chromosome1, chromosome2, newChromosome, changes);
         break;
     case TwoPoint:
-        return twoPoint(parent1, parent2);
-        break;
-    case MixCrossover:
     default:
-        int r = RANDOM(100);
-        if (r < 40)
-            return uniform(parent1, parent2);
-        else if (r < 65)
-            return onePoint(parent1, parent2);
-        else
-            return twoPoint(parent1, parent2);
+        twoPoint(chromosome1, chromosome2, newChromosome, changes);
         break;
     }
-}
 
-template <class T>
-void GeneticAlgorithm<T>::setChromosomeFixFunctionStatus(bool status)
-{
-    assert((!(status && chromosomeFixFunction == nullptr)) && "chromosomeFixFunction not found");
-    chromosomeFixFunctionStatus = status;
+    if (chromosomeFixFunctionStatus && !batchRepairFunctionStatus) // otherwise the caller repairs the whole block
+        chromosomeFixFunction(newChromosome);
+    if (changes && (chromosomeFixFunctionStatus || batchRepairFunctionStatus)) // the repair can change any byte
+        changes->known = false;
+    return method;
 }
 
 template <class T>
-void GeneticAlgorithm<T>::setChromosomeFixFunction(function<void(T &)> chromosomeFixFunction)
+int GeneticAlgorithm<T>::getModifiedRanges(byte *parent, byte *chromosome, vector<pair<int, int>> &modifiedRanges)
 {
-    this->chromosomeFixFunction = chromosomeFixFunction;
-    setChromosomeFixFunctionStatus(true);
+    const int sz = sizeof(T);
+    int modified = 0;
+    modifiedRanges.clear();
+    for (int i = 0; i < sz; i++)
+        if (parent[i] != chromosome[i])
+        {
+            int first = i;
+            while (i < sz && parent[i] != chromosome[i])
+                ++i;
+            modifiedRanges.push_back(make_pair(first, i));
+            modified += i - first;
+        }
+    return modified;
 }
 
 template <class T>
-int GeneticAlgorithm<T>::biasedRandom(int maxOutput)
+int GeneticAlgorithm<T>::recordedRanges(const OffspringChanges &changes, int parent, vector<pair<int, int>> &modifiedRanges)
 {
-    --maxOutput;
-    const int max_r = 5000;
-    double x = (RANDOM(max_r) + 1.0) / max_r; // [0.0002 , 1]
-    double sig = -maxOutput / 8.517193;       // 8.517193 = -log(0.0002)
-    return (int)(sig * log(x));               // Output [0,maxOutput[
+    // At most four ranges: sort them and merge the overlapping ones.
+    pair<int, int> ranges[4];
+    const int count = changes.count[parent];
+    copy(changes.ranges[parent], changes.ranges[parent] + count, ranges);
+    sort(ranges, ranges + count);
+
+    int modified = 0;
+    modifiedRanges.clear();
+    for (int i = 0; i < count; i++)
+        if (!modifiedRanges.empty() && ranges[i].first <= modifiedRanges.back().second)
+            modifiedRanges.back().second = max(modifiedRanges.back().second, ranges[i].second);
+        else
+            modifiedRanges.push_back(ranges[i]);
+    for (auto &range : modifiedRanges)
+        modified += range.second - range.first;
+    return modified;
 }
 
 template <class T>
-void GeneticAlgorithm<T>::prepareRouletteWheelSelection()
+Individual<T> GeneticAlgorithm<T>::evaluateOffspring(T &newChromosome, Individual<T> &parent1, Individual<T> &parent2, const OffspringChanges *changes)
 {
-    assert((populationSize > 2) && "No population yet.");
-    fitnessSum = 0;
-    fitnessValues.clear();
-    for (int i = 0; i < populationSize; i++)
+    if (deltaFitnessFunctionStatus)
     {
-        fitnessSum += population[i].getFitness();
-        fitnessValues.push_back(fitnessSum);
+        // Rescore from the parent that shares more bytes with the offspring. The buffers are reused, one set per thread.
+        static thread_local vector<pair<int, int>> modifiedRanges1, modifiedRanges2;
+        int modified1, modified2;
+        if (changes && changes->known)
+        {
+            modified1 = recordedRanges(*changes, 0, modifiedRanges1);
+            modified2 = recordedRanges(*changes, 1, modifiedRanges2);
+        }
+        else
+        {
+            byte *p = (byte *)&newChromosome;
+            modified1 = getModifiedRanges(parent1.getChromosomePointer(), p, modifiedRanges1);
+            modified2 = getModifiedRanges(parent2.getChromosomePointer(), p, modifiedRanges2);
+        }
+
+        Individual<T> &parent = (modified1 <= modified2) ? parent1 : parent2;
+        vector<pair<int, int>> &modifiedRanges = (modified1 <= modified2) ? modifiedRanges1 : modifiedRanges2;
+
+        if (!parent.isRejected()) // a rejected parent has no real fitness to start from
+        {
+            if (modifiedRanges.empty()) // a clone of its parent
+                return Individual<T>(fitnessFunction, newChromosome, parent.getFitness(), 0);
+
+            countEvaluations(1);
+            T &parentChromosome = *(T *)parent.getChromosomePointer();
+            double fitness = deltaFitnessFunction(newChromosome, parentChromosome, parent.getFitness(), modifiedRanges);
+            return Individual<T>(fitnessFunction, newChromosome, fitness, 0);
+        }
+    }
+
+    countEvaluations(1);
+    if (boundedFitnessFunctionStatus)
+    {
+        double fitness = boundedFitnessFunction(newChromosome, cutoff);
+        Individual<T> offspring(fitnessFunction, newChromosome, fitness, 0);
+        if (isnan(fitness))
+            offspring.reject(worstFitness());
+        return offspring;
+    }
+
+    return Individual<T>(fitnessFunction, newChromosome);
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setChromosomeFixFunctionStatus(bool status)
+{
+    assert((!(status && chromosomeFixFunction == nullptr)) && "chromosomeFixFunction not found");
+    chromosomeFixFunctionStatus = status;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setChromosomeFixFunction(function<void(T &)> chromosomeFixFunction)
+{
+    this->chromosomeFixFunction = chromosomeFixFunction;
+    setChromosomeFixFunctionStatus(true);
+}
+
+template <class T>
+void GeneticAlgorithm<T>::repairChromosome(T &chromosome)
+{
+    if (batchRepairFunctionStatus)
+    {
+        ScratchArena &arena = threadScratchArena();
+        arena.reset();
+        batchRepairFunction(&chromosome, 1, arena);
+    }
+    else if (chromosomeFixFunctionStatus)
+        chromosomeFixFunction(chromosome);
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setBatchRepairFunctionStatus(bool status)
+{
+    assert((!(status && batchRepairFunction == nullptr)) && "batchRepairFunction not found");
+    batchRepairFunctionStatus = status;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setBatchRepairFunction(function<void(T *, int, ScratchArena &)> batchRepairFunction, int blockSize)
+{
+    assert((blockSize > 0) && "blockSize must be greater than 0");
+    this->batchRepairFunction = batchRepairFunction;
+    repairBlockSize = blockSize;
+    setBatchRepairFunctionStatus(true);
+}
+
+template <class T>
+void GeneticAlgorithm<T>::repairBlock(T *chromosomes, int count, int firstIndex)
+{
+    RandomStream stream;
+    RandomScope scope(randomStream(stream, repairDraws + firstIndex));
+    ScratchArena &arena = threadScratchArena();
+    arena.reset();
+    batchRepairFunction(chromosomes, count, arena);
+}
+
+template <class T>
+void GeneticAlgorithm<T>::repairBlocks(T *chromosomes, int count, int firstIndex)
+{
+    const int blocks = (count + repairBlockSize - 1) / repairBlockSize;
+    parallelFor(blocks, [this, chromosomes, count, firstIndex](int b)
+                {
+                    const int first = b * repairBlockSize;
+                    repairBlock(chromosomes + first, min(repairBlockSize, count - first), firstIndex + first); });
+}
+
+template <class T>
+template <class Item>
+void GeneticAlgorithm<T>::repairItems(vector<Item> &items, T Item::*chromosome, int firstIndex)
+{
+    // The repair takes contiguous chromosomes, gather them and put them back.
+    static thread_local vector<T> block;
+    block.resize(items.size());
+    for (size_t i = 0; i < items.size(); i++)
+        block[i] = items[i].*chromosome;
+    repairBlocks(block.data(), (int)block.size(), firstIndex);
+    for (size_t i = 0; i < items.size(); i++)
+        items[i].*chromosome = block[i];
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setDeltaFitnessFunctionStatus(bool status)
+{
+    assert((!(status && deltaFitnessFunction == nullptr)) && "deltaFitnessFunction not found");
+    deltaFitnessFunctionStatus = status;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setDeltaFitnessFunction(function<double(T &, T &, double, const vector<pair<int, int>> &)> deltaFitnessFunction)
+{
+    this->deltaFitnessFunction = deltaFitnessFunction;
+    setDeltaFitnessFunctionStatus(true);
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setBoundedFitnessFunctionStatus(bool status)
+{
+    assert((!(status && boundedFitnessFunction == nullptr)) && "boundedFitnessFunction not found");
+    boundedFitnessFunctionStatus = status;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setBoundedFitnessFunction(function<double(T &, double)> boundedFitnessFunction, double cutoffPercentage)
+{
+    assert((cutoffPercentage == -1 || (cutoffPercentage > 0 && cutoffPercentage <= 100)) && "cutoffPercentage must be -1 or in ]0, 100]");
+    this->boundedFitnessFunction = boundedFitnessFunction;
+    this->cutoffPercentage = cutoffPercentage;
+    setBoundedFitnessFunctionStatus(true);
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setAsyncFitnessFunctionStatus(bool status)
+{
+    assert((!(status && asyncFitnessFunction == nullptr)) && "asyncFitnessFunction not found");
+    asyncFitnessFunctionStatus = status;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setAsyncFitnessFunction(function<void(T &, function<void(double)>)> asyncFitnessFunction, int maxInFlight)
+{
+    assert((maxInFlight > 0) && "maxInFlight must be greater than 0");
+    this->asyncFitnessFunction = asyncFitnessFunction;
+    this->maxInFlight = maxInFlight;
+    setAsyncFitnessFunctionStatus(true);
+}
+
+template <class T>
+void GeneticAlgorithm<T>::evaluateAsync(vector<T> &chromosomes, vector<double> &fitness)
+{
+    // A late done() must not touch a finished call, so the counter is shared with the callbacks.
+    struct State
+    {
+        int inFlight;
+        mutex inFlightMutex;
+        condition_variable inFlightCondition;
+    };
+    shared_ptr<State> state = make_shared<State>();
+    state->inFlight = 0;
+    fitness.assign(chromosomes.size(), REJECTED_FITNESS); // not submitted when stopped
+
+    for (size_t i = 0; i < chromosomes.size() && !isStopping(); i++)
+    {
+        {
+            unique_lock<mutex> lock(state->inFlightMutex);
+            state->inFlightCondition.wait(lock, [this, &state]
+                                          { return state->inFlight < maxInFlight; });
+            ++state->inFlight;
+        }
+
+        double *result = &fitness[i];
+        asyncFitnessFunction(chromosomes[i], [state, result](double value)
+                             {
+                                 lock_guard<mutex> lock(state->inFlightMutex);
+                                 *result = value;
+                                 --state->inFlight;
+                                 state->inFlightCondition.notify_all(); });
+    }
+
+    unique_lock<mutex> lock(state->inFlightMutex);
+    state->inFlightCondition.wait(lock, [&state]
+                                  { return state->inFlight == 0; });
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setEvaluatorPool(int processesCount, double timeout_ms, double penaltyFitness, int batchSize)
+{
+    function<double(T &)> fitnessFunction = this->fitnessFunction;
+    evaluatorPool.reset(); // stop the old workers first
+    evaluatorPool = make_shared<EvaluatorPool>(processesCount, (int)sizeof(T), [fitnessFunction](uint8_t *chromosome) -> double
+                                               { return fitnessFunction(*(T *)chromosome); },
+                                               timeout_ms, penaltyFitness, batchSize);
+}
+
+template <class T>
+void GeneticAlgorithm<T>::evaluateBatch(vector<T> &chromosomes, vector<Individual<T>> &individuals)
+{
+    vector<double> fitness;
+    evaluateChromosomes(chromosomes, fitness);
+
+    for (size_t i = 0; i < chromosomes.size(); i++)
+    {
+        individuals.push_back(Individual<T>(fitnessFunction, chromosomes[i], fitness[i], 0));
+        if (isnan(fitness[i]))
+            individuals.back().reject(worstFitness());
+        publish(individuals.back());
+    }
+}
+
+template <class T>
+void GeneticAlgorithm<T>::batchOffspring(int count, vector<Individual<T>> &newGeneration)
+{
+    vector<T> chromosomes(count);
+    vector<int> p1(count), p2(count);
+    vector<Selection> selectionUsed(count);
+    vector<Crossover> crossoverUsed(count);
+    for (int i = 0; i < count; i++)
+    {
+        RandomStream stream;
+        RandomScope scope(randomStream(stream, i));
+        selectionUsed[i] = selectParents(p1[i], p2[i]);
+        crossoverUsed[i] = mate(population[p1[i]], population[p2[i]], chromosomes[i]);
+    }
+    if (batchRepairFunctionStatus)
+        repairBlocks(chromosomes.data(), count);
+    if (isStopping())
+        return;
+
+    const int first = (int)newGeneration.size();
+    evaluateBatch(chromosomes, newGeneration);
+    for (int i = 0; i < count; i++)
+    {
+        creditOperators(selectionUsed[i], crossoverUsed[i], newGeneration[first + i], population[p1[i]], population[p2[i]]);
+        record(nextStatistics, newGeneration[first + i]);
+    }
+}
+
+template <class T>
+void GeneticAlgorithm<T>::evaluateChromosomes(vector<T> &chromosomes, vector<double> &fitness)
+{
+    countEvaluations(chromosomes.size());
+    if (evaluatorPool)
+    {
+        fitness.resize(chromosomes.size());
+        // NaN (lost evaluations) is rejected by the callers
+        if (!evaluatorPool->evaluate((uint8_t *)chromosomes.data(), (int)chromosomes.size(), fitness.data()) && verbose)
+            cout << "Evaluator pool: no worker process, " << evaluatorPool->getInProcessCount() << " evaluations in this process, "
+                 << evaluatorPool->getLostCount() << " lost\n";
+    }
+    else if (asyncFitnessFunctionStatus)
+        evaluateAsync(chromosomes, fitness);
+    else
+    {
+        fitness.resize(chromosomes.size());
+        parallelFor((int)chromosomes.size(), [this, &chromosomes, &fitness](int i)
+                    { fitness[i] = fitnessFunction(chromosomes[i]); });
+    }
+}
+
+template <class T>
+void GeneticAlgorithm<T>::prepareCutoff()
+{
+    int last = getPercentageSize(cutoffPercentage == -1 ? ElitePercentage : cutoffPercentage) - 1;
+    cutoff = population[max(0, min(last, populationSize - 1))].getLearnedFitness();
+}
+
+template <class T>
+int GeneticAlgorithm<T>::biasedRandom(int maxOutput)
+{
+    --maxOutput;
+    const int max_r = 5000;
+    double x = (RANDOM(max_r) + 1.0) / max_r; // [0.0002 , 1]
+    double sig = -maxOutput / 8.517193;       // 8.517193 = -log(0.0002)
+    return (int)(sig * log(x));               // Output [0,maxOutput[
+}
+
+template <class T>
+void GeneticAlgorithm<T>::prepareRouletteWheelSelection()
+{
+    assert((populationSize > 2) && "No population yet.");
+    fitnessSum = 0;
+    fitnessValues.clear();
+    for (int i = 0; i < populationSize; i++)
+    {
+        if (!nicheOrder.empty()) // by niche rank, the cleared individuals take no part
+        {
+            if (!ranked(i).isRejected() && nicheFitness[i] != worstFitness())
+                fitnessSum += nicheFitness[i];
+        }
+        else if (!population[i].isRejected())
+            fitnessSum += population[i].getLearnedFitness();
+        fitnessValues.push_back(fitnessSum);
     }
 }
 
@@ -477,138 +1604,1695 @@ void GeneticAlgorithm<T>::fastSelection(int &p1, int &p2)
 }
 
 template <class T>
-Individual<T> GeneticAlgorithm<T>::solve()
+Selection GeneticAlgorithm<T>::selectParents(int &p1, int &p2)
 {
-    assert((!population.empty()) && "No population, use initializePopulation(size)");
-    cout << "Start solving...\nMax Generation: " << terminationConditions.maxGeneration << "\n";
+    Selection method = selection;
+    if (method == MixSelection)
+    {
+        if (adaptiveOperatorSelectionStatus)
+            method = (Selection)selectionSelector.select(RANDOM(10000) / 10000.0);
+        else
+            method = (RANDOM(100) < 60) ? Fast : RouletteWheel;
+    }
 
-    terminationConditions.isFirstTime = true;
-    terminationConditions.maximizeFitness = maximizeFitness;
-    terminationConditions.setStartTime();
+    if (method == Fast)
+        fastSelection(p1, p2);
+    else
+        rouletteWheelSelection(p1, p2);
+    if (!nicheOrder.empty()) // ranks by niche fitness
+    {
+        p1 = nicheOrder[p1];
+        p2 = nicheOrder[p2];
+    }
+    return method;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setAdaptiveOperatorSelection(bool status, Adaptation adaptation)
+{
+    adaptiveOperatorSelectionStatus = status;
+    crossoverSelector.reset({40, 25, 35}, adaptation);
+    selectionSelector.reset({60, 40}, adaptation);
+}
+
+template <class T>
+void GeneticAlgorithm<T>::creditOperators(Selection selectionUsed, Crossover crossoverUsed, Individual<T> &offspring, Individual<T> &parent1, Individual<T> &parent2)
+{
+    if (!adaptiveOperatorSelectionStatus || isMultiObjective())
+        return;
+
+    double bestParent = maximizeFitness ? max(parent1.getFitness(), parent2.getFitness()) : min(parent1.getFitness(), parent2.getFitness());
+    double improvement = offspring.isRejected() ? 0 : offspring.getFitness() - bestParent;
+    if (!maximizeFitness)
+        improvement = -improvement;
+
+    if (crossover == MixCrossover)
+        crossoverSelector.credit(crossoverUsed, improvement);
+    if (selection == MixSelection)
+        selectionSelector.credit(selectionUsed, improvement);
+}
 
-    for (uint64_t generation = 0;; generation++)
+template <class T>
+void GeneticAlgorithm<T>::breedOffspring(int count, vector<Individual<T>> &newGeneration)
+{
+    if (surrogateScreeningStatus && (surrogateFunction != nullptr || archive.size() >= surrogateNeighbours))
     {
-        // Sorting the population
-        if (maximizeFitness)
-            sort(population.begin(), population.end());
-        else
-            sort(population.begin(), population.end(),
-                 [](Individual<T> a, Individual<T> b) -> bool
+        screenOffspring(count, newGeneration);
+        return;
+    }
+    if (isBatchEvaluation())
+    {
+        batchOffspring(count, newGeneration);
+        return;
+    }
+    if (pipelinedEvaluationStatus && threadPool && threadPool->size() > 1)
+    {
+        pipelineOffspring(count, newGeneration);
+        return;
+    }
+    if (batchRepairFunctionStatus)
+    {
+        repairedOffspring(count, newGeneration);
+        return;
+    }
+
+    for (int i = 0; i < count && !isStopping(); i++)
+    {
+        RandomStream stream;
+        RandomScope scope(randomStream(stream, i));
+        int p1, p2;
+        Selection selectionUsed = selectParents(p1, p2);
+
+        T newChromosome;
+        OffspringChanges changes;
+        Crossover crossoverUsed = mate(population[p1], population[p2], newChromosome, &changes);
+        newGeneration.push_back(evaluateOffspring(newChromosome, population[p1], population[p2], &changes));
+        publish(newGeneration.back());
+        record(nextStatistics, newGeneration.back());
+        creditOperators(selectionUsed, crossoverUsed, newGeneration.back(), population[p1], population[p2]);
+    }
+}
+
+template <class T>
+void GeneticAlgorithm<T>::repairedOffspring(int count, vector<Individual<T>> &newGeneration)
+{
+    vector<T> chromosomes(count);
+    vector<int> p1(count), p2(count);
+    vector<Selection> selectionUsed(count);
+    vector<Crossover> crossoverUsed(count);
+    for (int i = 0; i < count; i++)
+    {
+        RandomStream stream;
+        RandomScope scope(randomStream(stream, i));
+        selectionUsed[i] = selectParents(p1[i], p2[i]);
+        crossoverUsed[i] = mate(population[p1[i]], population[p2[i]], chromosomes[i]);
+    }
+    repairBlocks(chromosomes.data(), count);
+
+    for (int i = 0; i < count && !isStopping(); i++)
+    {
+        newGeneration.push_back(evaluateOffspring(chromosomes[i], population[p1[i]], population[p2[i]]));
+        publish(newGeneration.back());
+        record(nextStatistics, newGeneration.back());
+        creditOperators(selectionUsed[i], crossoverUsed[i], newGeneration.back(), population[p1[i]], population[p2[i]]);
+    }
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setSurrogateScreening(int candidatesFactor, int neighbours, int archiveSize)
+{
+    assert((candidatesFactor >= 1 && neighbours >= 1 && archiveSize >= neighbours) && "Invalid surrogate screening settings");
+    this->candidatesFactor = candidatesFactor;
+    surrogateNeighbours = neighbours;
+    this->archiveSize = archiveSize;
+    archive.reset(sizeof(T));
+    archiveFitness.clear();
+    archiveNext = 0;
+    surrogateScreeningStatus = true;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setSurrogateFunction(function<double(T &)> surrogateFunction)
+{
+    this->surrogateFunction = surrogateFunction;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setSurrogateScreeningStatus(bool status)
+{
+    assert((!(status && candidatesFactor == 0)) && "Use setSurrogateScreening first");
+    surrogateScreeningStatus = status;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::addToArchive(Individual<T> &individual)
+{
+    if (individual.isRejected()) // no real fitness to learn from
+        return;
+
+    if (archive.size() < archiveSize)
+    {
+        archive.insert(individual.getChromosomePointer());
+        archiveFitness.push_back(individual.getFitness());
+        return;
+    }
+
+    // The archive is full, replace the oldest chromosome.
+    archive.replace(archiveNext, individual.getChromosomePointer());
+    archiveFitness[archiveNext] = individual.getFitness();
+    archiveNext = (archiveNext + 1) % archiveSize;
+}
+
+template <class T>
+double GeneticAlgorithm<T>::surrogateScore(T &chromosome)
+{
+    if (surrogateFunction != nullptr)
+        return surrogateFunction(chromosome);
+
+    archive.nearest((byte *)&chromosome, surrogateNeighbours, neighbours);
+
+    double score = 0, weights = 0;
+    for (auto &neighbour : neighbours)
+    {
+        if (neighbour.first == 0) // already evaluated
+            return archiveFitness[neighbour.second];
+        double w = 1.0 / neighbour.first;
+        score += w * archiveFitness[neighbour.second];
+        weights += w;
+    }
+    return score / weights;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::screenOffspring(int count, vector<Individual<T>> &newGeneration)
+{
+    struct Candidate
+    {
+        T chromosome;
+        int p1, p2;
+        Selection selectionUsed;
+        Crossover crossoverUsed;
+        OffspringChanges changes;
+        double score;
+    };
+
+    vector<Candidate> candidates(count * candidatesFactor);
+    for (size_t i = 0; i < candidates.size(); i++)
+    {
+        RandomStream stream;
+        RandomScope scope(randomStream(stream, i));
+        Candidate &candidate = candidates[i];
+        candidate.selectionUsed = selectParents(candidate.p1, candidate.p2);
+        candidate.crossoverUsed = mate(population[candidate.p1], population[candidate.p2], candidate.chromosome, &candidate.changes);
+    }
+    if (batchRepairFunctionStatus)
+        repairItems(candidates, &Candidate::chromosome, 0);
+    for (auto &candidate : candidates)
+        candidate.score = surrogateScore(candidate.chromosome);
+
+    // Keep the most promising candidates.
+    bool maximize = maximizeFitness;
+    partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                 [maximize](const Candidate &a, const Candidate &b) -> bool
                  {
-                     if (a.getFitness() < b.getFitness())
-                         return true;
-                     if (a.getFitness() > b.getFitness())
-                         return false;
-                     return a.getAge() > b.getAge();
+                     return maximize ? a.score > b.score : a.score < b.score;
                  });
 
-        // Check termination conditions
-
-        if (generation == terminationConditions.maxGeneration)
-        {
-            cout << "Done with best fitness: " << population[0].getFitness() << "\n";
-            return population[0];
-        }
-        if (terminationConditions.checkTimeCondition())
-        {
-            cout << "Timeout\n";
-            return population[0];
-        }
-        if (terminationConditions.checkFitnessGoalCondition(population[0].getFitness()))
+    const int first = (int)newGeneration.size();
+    if (isBatchEvaluation())
+    {
+        vector<T> chromosomes(count);
+        for (int i = 0; i < count; i++)
+            chromosomes[i] = candidates[i].chromosome;
+        if (isStopping())
+            return;
+        evaluateBatch(chromosomes, newGeneration);
+    }
+    else
+        for (int i = 0; i < count && !isStopping(); i++)
         {
-            cout << "Reached to fitness goal: " << population[0].getFitness() << "\n";
-            return population[0];
+            newGeneration.push_back(evaluateOffspring(candidates[i].chromosome, population[candidates[i].p1], population[candidates[i].p2], &candidates[i].changes));
+            publish(newGeneration.back());
         }
-        if (terminationConditions.checkIterationsCondition(population[0].getFitness()))
+
+    for (int i = first; i < (int)newGeneration.size(); i++)
+    {
+        Candidate &candidate = candidates[i - first];
+        record(nextStatistics, newGeneration[i]);
+        addToArchive(newGeneration[i]);
+        creditOperators(candidate.selectionUsed, candidate.crossoverUsed, newGeneration[i], population[candidate.p1], population[candidate.p2]);
+    }
+}
+
+template <class T>
+void GeneticAlgorithm<T>::evaluateObjectives(vector<Individual<T>> &individuals)
+{
+    for (auto &individual : individuals)
+        if (individual.getObjectives().empty())
         {
-            cout << "Reached to max iterations\n";
-            return population[0];
+            individual.setObjectives(objectivesFunction(*(T *)individual.getChromosomePointer()));
+            assert((individual.getObjectives().size() == maximizeObjectives.size()) && "Wrong number of objectives");
         }
+}
 
-        vector<Individual<T>> newGeneration;
-
-        int elite = getPercentageSize(ElitePercentage);
+template <class T>
+void GeneticAlgorithm<T>::selectNonDominated(vector<Individual<T>> &individuals, int size)
+{
+    const int n = (int)individuals.size();
+    vector<vector<double>> objectives(n);
+    for (int i = 0; i < n; i++)
+    {
+        objectives[i] = individuals[i].getObjectives();
+        for (size_t o = 0; o < maximizeObjectives.size(); o++)
+            if (maximizeObjectives[o])
+                objectives[i][o] = -objectives[i][o];
+    }
 
-        if (kickOutAge == -1) // if kickOutAge is disabled
-            // Move the elite to the next generation.
-            for (int i = 0; i < elite; i++)
-            {
-                newGeneration.push_back(population[i]);
-                newGeneration[i].increaseAge();
-            }
-        else
-        {
-            // Move the young elite to the next generation.
+    vector<int> rank;
+    frontsCount = nonDominatedSort(objectives, rank);
 
-            int added = 0;
-            if (kickOutExceptBest || population[0].getAge() < kickOutAge || RANDOM(100) < 30) // Best one
-            {
-                newGeneration.push_back(population[0]);
-                newGeneration[0].increaseAge();
-                ++added;
-            }
+    vector<vector<int>> fronts(frontsCount);
+    for (int i = 0; i < n; i++)
+        fronts[rank[i]].push_back(i);
 
-            for (int i = 1; added < elite && i < populationSize; i++)
-                if (population[i].getAge() < kickOutAge || RANDOM(100) < 45)
-                {
-                    newGeneration.push_back(population[i]);
-                    newGeneration[added].increaseAge();
-                    ++added;
-                }
+    vector<double> crowding(n);
+    for (auto &front : fronts)
+        crowdingDistance(objectives, front, crowding);
 
-            /// Add new individuals if adders are less than elite to keep the population size the same.
-            for (int i = added; i < elite; i++)
-            {
-                T chromosome = generateRandomChromosome();
-                newGeneration.push_back(Individual<T>(fitnessFunction, chromosome));
-                ++added;
-            }
-        }
+    for (int i = 0; i < n; i++)
+    {
+        double c = crowding[i];
+        individuals[i].setFitness(2.0 * (frontsCount - rank[i]) + (isinf(c) ? 1.0 : c / (1.0 + c)));
+    }
 
-        // Prepare parents' selection method.
-        switch (selection)
-        {
-        case Fast:
-            prepareFastSelection();
-            break;
-        case RouletteWheel:
-            prepareRouletteWheelSelection();
-            break;
-        case MixSelection:
-        default:
-            prepareFastSelection();
-            prepareRouletteWheelSelection();
-            break;
-        }
+    sort(individuals.begin(), individuals.end());
+    if ((int)individuals.size() > size)
+        individuals.erase(individuals.begin() + size, individuals.end());
+}
 
-        int s = populationSize - elite;
-        for (int i = 0; i < s; i++)
-        {
-            int p1, p2;
+template <class T>
+vector<Individual<T>> GeneticAlgorithm<T>::getParetoFront()
+{
+    assert(isMultiObjective() && "Not a multi-objective problem");
+    vector<Individual<T>> front;
+    for (auto &individual : population)
+    {
+        if (individual.getFitness() < 2.0 * frontsCount)
+            continue;
 
-            // Select parents
-            switch (selection)
+        bool duplicate = false; // skip clones of the same chromosome
+        for (auto &member : front)
+            if (memcmp(member.getChromosomePointer(), individual.getChromosomePointer(), sizeof(T)) == 0)
             {
-            case Fast:
-                fastSelection(p1, p2);
-                break;
-            case RouletteWheel:
-                rouletteWheelSelection(p1, p2);
-                break;
-            case MixSelection:
-            default:
-                if (RANDOM(100) < 60)
-                    fastSelection(p1, p2);
-                else
-                    rouletteWheelSelection(p1, p2);
+                duplicate = true;
                 break;
             }
+        if (!duplicate)
+            front.push_back(individual);
+    }
+    return front;
+}
 
-            Individual<T> offspring = mate(population[p1], population[p2]);
-            newGeneration.push_back(offspring);
+template <class T>
+uint64_t GeneticAlgorithm<T>::hashChromosome(byte *chromosome)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (int i = 0; i < (int)sizeof(T); i++)
+        hash = (hash ^ chromosome[i]) * 1099511628211ULL;
+    return hash;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::eliminateDuplicates(vector<Individual<T>> &individuals, PopulationStatistics *statistics)
+{
+    const int sz = sizeof(T);
+    unordered_map<uint64_t, vector<int>> seen;
+    auto isDuplicate = [&](byte *chromosome) -> bool
+    {
+        unordered_map<uint64_t, vector<int>>::iterator bucket = seen.find(hashChromosome(chromosome));
+        if (bucket != seen.end())
+            for (int j : bucket->second)
+                if (memcmp(individuals[j].getChromosomePointer(), chromosome, sz) == 0)
+                    return true;
+        return false;
+    };
+    // With an evaluator pool or an asynchronous fitness function, the replacements are evaluated together at the end.
+    const bool batch = isBatchEvaluation();
+    vector<int> replaced;
+    vector<T> replacements;
+    vector<Individual<T>> originals;
+
+    for (int i = 0; i < (int)individuals.size(); i++)
+    {
+        if (isDuplicate(individuals[i].getChromosomePointer()))
+        {
+            Individual<T> original = individuals[i];
+            T newChromosome;
+            byte *p = (byte *)&newChromosome;
+
+            // Flip more bits at each attempt, then give up and use a new random chromosome.
+            for (int attempt = 1;; attempt++)
+            {
+                if (attempt > 3)
+                {
+                    newChromosome = generateRandomChromosome();
+                    break;
+                }
+                newChromosome = original.getChromosome();
+                for (int j = 0; j < attempt; j++)
+                    FLIP_BIT(p[RANDOM(sz)], RANDOM(8));
+                repairChromosome(newChromosome);
+                if (!isDuplicate(p))
+                    break;
+            }
+            if (batch)
+            {
+                replaced.push_back(i);
+                replacements.push_back(newChromosome);
+                originals.push_back(original);
+                individuals[i].setChromosome(newChromosome); // seen by the next duplicate checks
+            }
+            else
+            {
+                individuals[i] = evaluateOffspring(newChromosome, original, original);
+                if (statistics)
+                {
+                    statistics->remove(original.getChromosomePointer(), original.getFitness());
+                    statistics->add(individuals[i].getChromosomePointer(), individuals[i].getFitness());
+                }
+            }
+        }
+        seen[hashChromosome(individuals[i].getChromosomePointer())].push_back(i);
+    }
+    if (replaced.empty())
+        return;
+
+    vector<Individual<T>> evaluated;
+    evaluateBatch(replacements, evaluated);
+    for (size_t k = 0; k < replaced.size(); k++)
+    {
+        individuals[replaced[k]] = evaluated[k];
+        if (statistics)
+        {
+            statistics->remove(originals[k].getChromosomePointer(), originals[k].getFitness());
+            statistics->add(evaluated[k].getChromosomePointer(), evaluated[k].getFitness());
+        }
+    }
+}
+
+template <class T>
+void GeneticAlgorithm<T>::packPopulation(vector<uint64_t> &packed, int &words)
+{
+    words = (sizeof(T) + 7) / 8;
+    packed.assign((size_t)words * population.size(), 0);
+    for (size_t i = 0; i < population.size(); i++)
+        memcpy(&packed[i * words], population[i].getChromosomePointer(), sizeof(T));
+}
+
+template <class T>
+double GeneticAlgorithm<T>::getDiversity(int samples)
+{
+    assert((!population.empty()) && "No population yet.");
+    const int n = (int)population.size();
+    int words;
+    vector<uint64_t> packed;
+    packPopulation(packed, words);
+
+    uint64_t distance = 0, pairs = 0;
+    if (samples == -1 || (uint64_t)samples >= (uint64_t)n * (n - 1) / 2)
+    {
+        for (int i = 0; i < n; i++)
+            for (int j = i + 1; j < n; j++)
+                distance += hammingDistance(&packed[(size_t)i * words], &packed[(size_t)j * words], words);
+        pairs = (uint64_t)n * (n - 1) / 2;
+    }
+    else
+        for (; (int)pairs < samples; pairs++)
+        {
+            int i = RANDOM(n), j = RANDOM(n - 1);
+            j += (j >= i); // j != i
+            distance += hammingDistance(&packed[(size_t)i * words], &packed[(size_t)j * words], words);
+        }
+
+    return pairs == 0 ? 0 : (double)distance / pairs / (sizeof(T) * 8);
+}
+
+template <class T>
+vector<double> GeneticAlgorithm<T>::getAlleleFrequencies()
+{
+    assert((!population.empty()) && "No population yet.");
+    const int bits = sizeof(T) * 8;
+    vector<uint32_t> ones(bits, 0);
+    for (auto &individual : population)
+    {
+        byte *p = individual.getChromosomePointer();
+        for (int i = 0; i < bits; i++)
+            ones[i] += (p[i >> 3] >> (i & 7)) & 1;
+    }
+
+    vector<double> frequencies(bits);
+    for (int i = 0; i < bits; i++)
+        frequencies[i] = (double)ones[i] / population.size();
+    return frequencies;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setRestartStrategy(uint64_t stagnationGenerations, double populationGrowth, int maxRestarts, int hallOfFameSize, int maxPopulationSize)
+{
+    assert((stagnationGenerations > 0 && populationGrowth >= 1 && hallOfFameSize > 0 && maxPopulationSize > 10) && "Invalid restart strategy settings");
+    this->stagnationGenerations = stagnationGenerations;
+    this->populationGrowth = populationGrowth;
+    this->maxRestarts = maxRestarts;
+    this->hallOfFameSize = hallOfFameSize;
+    this->maxPopulationSize = maxPopulationSize;
+    restartStrategyStatus = true;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::addToHallOfFame(Individual<T> &individual)
+{
+    if ((int)hallOfFame.size() == hallOfFameSize && !isBetter(individual, hallOfFame.back()))
+        return;
+
+    for (auto &member : hallOfFame)
+        if (memcmp(member.getChromosomePointer(), individual.getChromosomePointer(), sizeof(T)) == 0)
+            return;
+
+    int i = (int)hallOfFame.size();
+    hallOfFame.push_back(individual);
+    for (; i > 0 && isBetter(hallOfFame[i], hallOfFame[i - 1]); i--)
+        swap(hallOfFame[i], hallOfFame[i - 1]);
+    if ((int)hallOfFame.size() > hallOfFameSize)
+        hallOfFame.pop_back();
+}
+
+template <class T>
+bool GeneticAlgorithm<T>::checkRestart()
+{
+    if (!restartStrategyStatus || isMultiObjective())
+        return false;
+
+    for (int i = 0; i < hallOfFameSize && i < populationSize; i++)
+        addToHallOfFame(population[i]);
+
+    const double bestFitness = getPopulationBest().getFitness();
+    if (stagnation == 0 || (maximizeFitness ? bestFitness > restartBestFitness : bestFitness < restartBestFitness))
+    {
+        restartBestFitness = bestFitness;
+        stagnation = 1;
+        return false;
+    }
+
+    if (++stagnation <= stagnationGenerations || (maxRestarts != -1 && restartsCount >= maxRestarts))
+        return false;
+
+    ++restartsCount;
+    stagnation = 0;
+    int size = (int)min(ceil(populationSize * populationGrowth), (double)max(maxPopulationSize, populationSize));
+    if (verbose)
+        cout << "Restart " << restartsCount << " with population size: " << size << "\n";
+
+    // Generate the new population first, then evaluate it as one batch (in parallel, or by the evaluator pool).
+    vector<T> chromosomes;
+    for (int i = 0; i < size; i++)
+    {
+        RandomStream stream;
+        RandomScope scope(randomStream(stream, i));
+        chromosomes.push_back(generateRandomChromosome(!batchRepairFunctionStatus));
+    }
+    if (batchRepairFunctionStatus)
+        repairBlocks(chromosomes.data(), size);
+
+    // One chunk of the size of the old population at a time, so the stop checks come as often as in a generation.
+    vector<Individual<T>> restarted;
+    vector<T> chunk;
+    for (int first = 0; first < size; first += populationSize)
+    {
+        if (isStopping())
+        {
+            --restartsCount; // the run stops with the old population
+            return false;
+        }
+        chunk.assign(chromosomes.begin() + first, chromosomes.begin() + min(size, first + populationSize));
+        evaluateBatch(chunk, restarted);
+    }
+
+    population.swap(restarted);
+    populationStatistics.reset(sizeof(T));
+    for (int i = 0; i < size; i++)
+        record(populationStatistics, population[i]);
+    populationSize = size;
+
+    // The max iterations and the slope conditions start over with the new population.
+    terminationConditions.isFirstTime = true;
+    terminationConditions.resetSlope();
+    return true;
+}
+
+template <class T>
+Individual<T> &GeneticAlgorithm<T>::getBestIndividual()
+{
+    Individual<T> &best = getPopulationBest();
+    if (restartStrategyStatus && !hallOfFame.empty() && isBetter(hallOfFame[0], best))
+        return hallOfFame[0];
+    return best;
+}
+
+template <class T>
+Individual<T> &GeneticAlgorithm<T>::getPopulationBest()
+{
+    if (!localSearchStatus || lamarckian)
+        return population[0];
+    size_t best = 0;
+    for (size_t i = 1; i < population.size(); i++)
+        if (isBetter(population[i], population[best]))
+            best = i;
+    return population[best];
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setThreadsCount(int threadsCount, bool pinThreads)
+{
+    if (threadsCount == 1)
+        threadPool.reset();
+    else
+        threadPool = make_shared<ThreadPool>(threadsCount, pinThreads);
+    if (verbose && pinThreads && threadPool)
+        cout << threadPool->getPlacement();
+}
+
+template <class T>
+void GeneticAlgorithm<T>::parallelFor(int count, function<void(int)> task)
+{
+    if (threadPool)
+        threadPool->parallelFor(0, count, task);
+    else
+        for (int i = 0; i < count; i++)
+            task(i);
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setLocalSearch(LocalSearch method, int topCount, int evaluationsBudget, bool lamarckian)
+{
+    assert((topCount > 0 && evaluationsBudget > 0) && "Invalid local search settings");
+    localSearchMethod = method;
+    localSearchFunction = nullptr;
+    localSearchTopCount = topCount;
+    localSearchBudget = evaluationsBudget;
+    this->lamarckian = lamarckian;
+    localSearchStatus = true;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setLocalSearchFunction(function<double(T &, double, int)> localSearchFunction, int topCount, int evaluationsBudget, bool lamarckian)
+{
+    assert((localSearchFunction != nullptr) && "No local search function");
+    setLocalSearch(BitFlip, topCount, evaluationsBudget, lamarckian);
+    this->localSearchFunction = localSearchFunction;
+}
+
+template <class T>
+double GeneticAlgorithm<T>::bitFlipSearch(T &chromosome, double fitness, int evaluationsBudget, uint32_t seed)
+{
+    const int bits = sizeof(T) * 8;
+    byte *p = (byte *)&chromosome;
+    minstd_rand random(seed);
+
+    // First improvement, scan the bits from a random start until a whole pass brings nothing.
+    int bit = random() % bits, sinceImprovement = 0;
+    for (int evaluations = 0; evaluations < evaluationsBudget && sinceImprovement < bits && !isStopping(); evaluations++)
+    {
+        T candidate = chromosome;
+        FLIP_BIT(((byte *)&candidate)[bit >> 3], bit & 7);
+        repairChromosome(candidate);
+
+        double candidateFitness = evaluateCandidate(candidate);
+        if (maximizeFitness ? candidateFitness > fitness : candidateFitness < fitness)
+        {
+            memcpy(p, &candidate, sizeof(T));
+            fitness = candidateFitness;
+            sinceImprovement = 0;
+        }
+        else
+            ++sinceImprovement;
+        bit = (bit + 1) % bits;
+    }
+    return fitness;
+}
+
+template <class T>
+double GeneticAlgorithm<T>::twoOptSearch(T &chromosome, double fitness, int evaluationsBudget, uint32_t seed)
+{
+    const int sz = sizeof(T);
+    const int pairs = sz * (sz - 1) / 2;
+    if (pairs == 0)
+        return fitness;
+    minstd_rand random(seed);
+
+    // First improvement over the segments [i, j], starting from a random segment.
+    int i = random() % (sz - 1), j = i + 1, sinceImprovement = 0;
+    for (int evaluations = 0; evaluations < evaluationsBudget && sinceImprovement < pairs && !isStopping(); evaluations++)
+    {
+        T candidate = chromosome;
+        byte *c = (byte *)&candidate;
+        reverse(c + i, c + j + 1);
+        repairChromosome(candidate);
+
+        double candidateFitness = evaluateCandidate(candidate);
+        if (maximizeFitness ? candidateFitness > fitness : candidateFitness < fitness)
+        {
+            chromosome = candidate;
+            fitness = candidateFitness;
+            sinceImprovement = 0;
+        }
+        else
+            ++sinceImprovement;
+
+        if (++j == sz)
+        {
+            i = (i + 1) % (sz - 1);
+            j = i + 1;
+        }
+    }
+    return fitness;
+}
+
+template <class T>
+double GeneticAlgorithm<T>::evaluateCandidate(T &candidate)
+{
+    if (!isBatchEvaluation())
+    {
+        countEvaluations(1);
+        return fitnessFunction(candidate);
+    }
+    vector<T> chromosomes(1, candidate);
+    vector<double> fitness;
+    evaluateChromosomes(chromosomes, fitness);
+    return fitness[0]; // NaN (a failed evaluation) is never an improvement
+}
+
+template <class T>
+bool GeneticAlgorithm<T>::applyLocalSearch()
+{
+    if (!localSearchStatus || isMultiObjective())
+        return false;
+
+    vector<int> selected;
+    vector<uint32_t> seeds;
+    for (int i = 0; i < populationSize && (int)selected.size() < localSearchTopCount; i++)
+        if (population[i].getAge() == 0 && !population[i].isRejected())
+        {
+            selected.push_back(i);
+            seeds.push_back((uint32_t)RANDOM(2147483647) + 1);
+        }
+    if (selected.empty())
+        return false;
+
+    if (trackingStatistics)
+        for (int i : selected)
+            populationStatistics.remove(population[i].getChromosomePointer(), population[i].getFitness());
+
+    auto search = [this, &selected, &seeds](int k)
+    {
+        Individual<T> &individual = population[selected[k]];
+        T chromosome = individual.getChromosome();
+        double fitness = individual.getFitness();
+
+        if (localSearchFunction != nullptr)
+            fitness = localSearchFunction(chromosome, fitness, localSearchBudget);
+        else if (localSearchMethod == TwoOpt)
+            fitness = twoOptSearch(chromosome, fitness, localSearchBudget, seeds[k]);
+        else
+            fitness = bitFlipSearch(chromosome, fitness, localSearchBudget, seeds[k]);
+
+        if (lamarckian)
+        {
+            individual.setChromosome(chromosome);
+            individual.setFitness(fitness);
+        }
+        else // the individual keeps the fitness of its own chromosome, the improved one only ranks it
+            individual.setLearnedFitness(fitness);
+        bestSoFar.offer(chromosome, fitness);
+    };
+    // The evaluator pool and the asynchronous fitness function take one caller at a time.
+    if (isBatchEvaluation() && localSearchFunction == nullptr)
+        for (int k = 0; k < (int)selected.size(); k++)
+            search(k);
+    else
+        parallelFor((int)selected.size(), search);
+
+    for (int i : selected)
+        record(populationStatistics, population[i]);
+    return true;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::sortPopulation()
+{
+    if (populationSorted)
+    {
+        populationSorted = false;
+        return;
+    }
+    sort(population.begin(), population.end(),
+         [this](const Individual<T> &a, const Individual<T> &b) -> bool
+         { return comesBefore(a, b); });
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setPipelinedEvaluation(bool status, int chunkSize, int queueCapacity)
+{
+    assert((chunkSize > 0 && queueCapacity > 0) && "Invalid pipelined evaluation settings");
+    pipelinedEvaluationStatus = status;
+    this->chunkSize = chunkSize;
+    this->queueCapacity = queueCapacity;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::pipelineOffspring(int count, vector<Individual<T>> &newGeneration)
+{
+    struct Offspring
+    {
+        T chromosome;
+        int p1, p2;
+        Selection selectionUsed;
+        Crossover crossoverUsed;
+        OffspringChanges changes;
+    };
+    // Pool threads may take the queue after the last chunk is done, so the state is shared with them.
+    struct Pipeline
+    {
+        BoundedQueue<int> queue;
+        vector<vector<Offspring>> offspring;
+        vector<vector<Individual<T>>> results;
+        vector<PopulationStatistics> statistics;
+        atomic<int> done;
+        mutex doneMutex;
+        condition_variable doneCondition;
+    };
+
+    const int chunks = (count + chunkSize - 1) / chunkSize;
+    shared_ptr<Pipeline> pipeline = make_shared<Pipeline>();
+    pipeline->queue.setCapacity(queueCapacity);
+    pipeline->offspring.resize(chunks);
+    pipeline->results.resize(chunks);
+    pipeline->statistics.resize(chunks, PopulationStatistics(trackingStatistics ? (int)sizeof(T) : 0));
+    pipeline->done = 0;
+    const bool sortChunks = !isMultiObjective();
+
+    function<void(int)> evaluateChunk = [this, pipeline, chunks, sortChunks](int c)
+    {
+        if (batchRepairFunctionStatus && !isStopping())
+        {
+            // The whole chunk is one block, repaired on this thread.
+            static thread_local vector<T> block;
+            vector<Offspring> &chunk = pipeline->offspring[c];
+            block.resize(chunk.size());
+            for (size_t i = 0; i < chunk.size(); i++)
+                block[i] = chunk[i].chromosome;
+            repairBlock(block.data(), (int)block.size(), c * chunkSize);
+            for (size_t i = 0; i < chunk.size(); i++)
+                chunk[i].chromosome = block[i];
+        }
+        vector<Individual<T>> &results = pipeline->results[c];
+        results.reserve(pipeline->offspring[c].size());
+        for (auto &o : pipeline->offspring[c])
+        {
+            if (isStopping())
+                break;
+            results.push_back(evaluateOffspring(o.chromosome, population[o.p1], population[o.p2], &o.changes));
+            publish(results.back());
+            record(pipeline->statistics[c], results.back());
+        }
+        if (sortChunks)
+            sort(results.begin(), results.end(),
+                 [this](const Individual<T> &a, const Individual<T> &b) -> bool
+                 { return comesBefore(a, b); });
+
+        if (++pipeline->done == chunks)
+        {
+            lock_guard<mutex> lock(pipeline->doneMutex);
+            pipeline->doneCondition.notify_all();
+        }
+    };
+
+    const int helpers = min(threadPool->size() - 1, chunks);
+    for (int i = 0; i < helpers; i++)
+        threadPool->submit([pipeline, evaluateChunk]()
+                           {
+                               int c;
+                               while (pipeline->queue.pop(c))
+                                   evaluateChunk(c); });
+
+    // Breeding uses rand(), so it stays on this thread.
+    for (int c = 0; c < chunks; c++)
+    {
+        vector<Offspring> &chunk = pipeline->offspring[c];
+        if (!isStopping()) // the chunks left empty are still counted as done
+            chunk.resize(min(chunkSize, count - c * chunkSize));
+        for (size_t i = 0; i < chunk.size(); i++)
+        {
+            RandomStream stream;
+            RandomScope scope(randomStream(stream, c * chunkSize + i));
+            Offspring &o = chunk[i];
+            o.selectionUsed = selectParents(o.p1, o.p2);
+            o.crossoverUsed = mate(population[o.p1], population[o.p2], o.chromosome, &o.changes);
+        }
+        if (!pipeline->queue.tryPush(c))
+            evaluateChunk(c);
+    }
+    pipeline->queue.close();
+
+    int c;
+    while (pipeline->queue.tryPop(c))
+        evaluateChunk(c);
+    {
+        unique_lock<mutex> lock(pipeline->doneMutex);
+        pipeline->doneCondition.wait(lock, [&pipeline, chunks]
+                                     { return pipeline->done == chunks; });
+    }
+
+    // The individuals already in the new generation are the first sorted run.
+    vector<size_t> bounds(1, 0);
+    if (sortChunks)
+        sort(newGeneration.begin(), newGeneration.end(),
+             [this](const Individual<T> &a, const Individual<T> &b) -> bool
+             { return comesBefore(a, b); });
+    bounds.push_back(newGeneration.size());
+
+    for (int c = 0; c < chunks; c++)
+    {
+        for (size_t i = 0; i < pipeline->results[c].size(); i++)
+        {
+            Offspring &o = pipeline->offspring[c][i];
+            creditOperators(o.selectionUsed, o.crossoverUsed, pipeline->results[c][i], population[o.p1], population[o.p2]);
+        }
+        if (trackingStatistics)
+            nextStatistics.merge(pipeline->statistics[c]);
+        newGeneration.insert(newGeneration.end(), make_move_iterator(pipeline->results[c].begin()), make_move_iterator(pipeline->results[c].end()));
+        bounds.push_back(newGeneration.size());
+    }
+    if (!sortChunks)
+        return;
+
+    // Merge the sorted runs pairwise.
+    auto first = newGeneration.begin();
+    while (bounds.size() > 2)
+    {
+        vector<size_t> merged(1, bounds[0]);
+        size_t i = 0;
+        for (; i + 2 < bounds.size(); i += 2)
+        {
+            inplace_merge(first + bounds[i], first + bounds[i + 1], first + bounds[i + 2],
+                          [this](const Individual<T> &a, const Individual<T> &b) -> bool
+                          { return comesBefore(a, b); });
+            merged.push_back(bounds[i + 2]);
+        }
+        if (i + 1 < bounds.size())
+            merged.push_back(bounds.back());
+        bounds.swap(merged);
+    }
+    populationSorted = true; // the new generation is ranked, the next sort has nothing to do
+}
+
+template <class T>
+void GeneticAlgorithm<T>::initializeMappedPopulation(int size, const string &path, int chunkSize)
+{
+    population.clear();
+    if (!reproducible)
+        srand((unsigned int)time(0));
+    assert((size > 10) && "Population size must be greater than 10.");
+    assert((chunkSize > 0) && "chunkSize must be greater than 0");
+    bool opened = mappedPopulation.open(path, size, (int)sizeof(T));
+    assert(opened && "Can not create the population file");
+    (void)opened;
+
+    populationSize = size;
+    mappedChunkSize = chunkSize;
+    mappedFitness.assign(size, 0);
+    mappedAge.assign(size, 0);
+    nextFitness.assign(size, 0);
+    nextAge.assign(size, 0);
+
+    mappedPopulation.adviseSequential(0, size);
+    vector<T> chunk;
+    vector<double> fitness;
+    for (int first = 0; first < size; first += chunkSize)
+    {
+        chunk.clear();
+        currentGeneration = initialGeneration;
+        for (int i = first; i < min(size, first + chunkSize); i++)
+        {
+            RandomStream stream;
+            RandomScope scope(randomStream(stream, i));
+            chunk.push_back(generateRandomChromosome(!batchRepairFunctionStatus));
+        }
+        if (batchRepairFunctionStatus)
+            repairBlocks(chunk.data(), (int)chunk.size(), first);
+        evaluateChromosomes(chunk, fitness);
+        for (size_t i = 0; i < chunk.size(); i++)
+        {
+            memcpy(mappedPopulation.chromosome(first + i), &chunk[i], sizeof(T));
+            mappedFitness[first + i] = isnan(fitness[i]) ? worstFitness() : fitness[i];
+        }
+    }
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setNiching(Niching method, int radius, int capacity, double alpha, int tablesCount)
+{
+    assert((radius > 0 && capacity > 0 && alpha > 0 && tablesCount > 0) && "Invalid niching settings");
+    nichingMethod = method;
+    nicheRadius = radius;
+    nicheCapacity = capacity;
+    nicheAlpha = alpha;
+    nicheTables = tablesCount;
+    nichingStatus = true;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setNichingStatus(bool status)
+{
+    assert((!(status && nicheRadius == 0)) && "Use setNiching first");
+    nichingStatus = status;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::resetNicheIndex()
+{
+    // About radius bits apart, a pair still shares the buckets of a table with probability 1/e.
+    const int bits = sizeof(T) * 8;
+    nicheIndex.reset(sizeof(T), nicheTables, max(1, min(24, bits / nicheRadius)));
+}
+
+template <class T>
+void GeneticAlgorithm<T>::clearNiches(int capacity, vector<int> &kept, vector<int> &cleared)
+{
+    // Only the first individual of each niche is indexed, the next ones join the niche of their nearest winner.
+    resetNicheIndex();
+    vector<int> nicheSize;
+    vector<pair<int, int>> neighbours;
+    kept.clear();
+    cleared.clear();
+    for (int i = 0; i < (int)population.size(); i++)
+    {
+        byte *chromosome = population[i].getChromosomePointer();
+        if (population[i].isRejected())
+        {
+            cleared.push_back(i);
+            continue;
+        }
+        nicheIndex.within(chromosome, nicheRadius - 1, neighbours);
+        if (neighbours.empty())
+        {
+            nicheIndex.insert(chromosome);
+            nicheSize.push_back(1);
+            kept.push_back(i);
+        }
+        else if (nicheSize[neighbours[0].second] < capacity)
+        {
+            ++nicheSize[neighbours[0].second];
+            kept.push_back(i);
+        }
+        else
+            cleared.push_back(i);
+    }
+}
+
+template <class T>
+void GeneticAlgorithm<T>::computeNiches()
+{
+    const int n = (int)population.size();
+    nicheOrder.clear();
+    nicheFitness.clear();
+
+    if (nichingMethod == Clearing)
+    {
+        vector<int> kept, cleared;
+        clearNiches(nicheCapacity, kept, cleared);
+        for (int i : kept)
+        {
+            nicheOrder.push_back(i);
+            nicheFitness.push_back(population[i].getLearnedFitness());
+        }
+        for (int i : cleared)
+        {
+            nicheOrder.push_back(i);
+            nicheFitness.push_back(worstFitness());
+        }
+        return;
+    }
+
+    // Fitness sharing: the niche count of an individual is the sum of 1 - (d / radius)^alpha over its neighbours (itself included).
+    resetNicheIndex();
+    for (auto &individual : population)
+        nicheIndex.insert(individual.getChromosomePointer());
+    vector<double> shared(n);
+    vector<pair<int, int>> neighbours;
+    for (int i = 0; i < n; i++)
+    {
+        if (population[i].isRejected())
+        {
+            shared[i] = worstFitness();
+            continue;
+        }
+        nicheIndex.within(population[i].getChromosomePointer(), nicheRadius - 1, neighbours);
+        double nicheCount = 0;
+        for (auto &neighbour : neighbours)
+            nicheCount += 1 - pow((double)neighbour.first / nicheRadius, nicheAlpha);
+        nicheCount = max(nicheCount, 1.0);
+
+        // Make the fitness worse in proportion to the niche count, whatever its sign.
+        double fitness = population[i].getLearnedFitness();
+        shared[i] = (maximizeFitness == (fitness >= 0)) ? fitness / nicheCount : fitness * nicheCount;
+    }
+
+    for (int i = 1; i < n; i++) // the population is sorted, the ties keep its order
+        nicheOrder.push_back(i);
+    bool maximize = maximizeFitness;
+    stable_sort(nicheOrder.begin(), nicheOrder.end(), [&shared, maximize](int a, int b) -> bool
+                { return maximize ? shared[a] > shared[b] : shared[a] < shared[b]; });
+    nicheOrder.insert(nicheOrder.begin(), 0); // the best individual stays in the elite
+    for (int i : nicheOrder)
+        nicheFitness.push_back(shared[i]);
+}
+
+template <class T>
+vector<Individual<T>> GeneticAlgorithm<T>::getNiches()
+{
+    assert((nicheRadius > 0) && "Use setNiching first");
+    vector<int> order(population.size());
+    for (size_t i = 0; i < order.size(); i++)
+        order[i] = (int)i;
+    sort(order.begin(), order.end(), [this](int a, int b) -> bool
+         { return comesBefore(population[a], population[b]); });
+
+    // The winners are few, they are compared exactly (the hashing could miss a close pair).
+    const int words = (sizeof(T) + 7) / 8;
+    vector<uint64_t> winners, packed(words);
+    vector<Individual<T>> niches;
+    for (int i : order)
+    {
+        if (population[i].isRejected())
+            continue;
+        packed[words - 1] = 0;
+        memcpy(packed.data(), population[i].getChromosomePointer(), sizeof(T));
+        bool covered = false;
+        for (size_t w = 0; w < niches.size() && !covered; w++)
+            covered = hammingDistance(packed.data(), &winners[w * words], words) < nicheRadius;
+        if (covered)
+            continue;
+        winners.insert(winners.end(), packed.begin(), packed.end());
+        niches.push_back(population[i]);
+    }
+    return niches;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::setSeed(uint64_t seed)
+{
+    this->seed = seed;
+    reproducible = true;
+}
+
+template <class T>
+T GeneticAlgorithm<T>::regenerateOffspring(uint64_t generation, int index)
+{
+    assert((reproducible && !population.empty()) && "Use setSeed and solve first");
+    currentGeneration = (uint32_t)generation;
+    prepareFastSelection();
+    prepareRouletteWheelSelection();
+
+    RandomStream stream;
+    RandomScope scope(randomStream(stream, index));
+    int p1, p2;
+    selectParents(p1, p2);
+    T newChromosome;
+    mate(population[p1], population[p2], newChromosome);
+    if (batchRepairFunctionStatus)
+        repairBlock(&newChromosome, 1, index);
+    return newChromosome;
+}
+
+template <class T>
+Individual<T> GeneticAlgorithm<T>::getMappedIndividual(int index)
+{
+    T chromosome;
+    memcpy(&chromosome, mappedPopulation.chromosome(index), sizeof(T));
+    return Individual<T>(fitnessFunction, chromosome, mappedFitness[index], mappedAge[index]);
+}
+
+template <class T>
+Individual<T> GeneticAlgorithm<T>::stoppedResult()
+{
+    T chromosome;
+    double fitness;
+    if (!bestSoFar.read(chromosome, fitness))
+        return isMappedPopulation() ? getMappedIndividual(0) : getBestIndividual();
+    return Individual<T>(fitnessFunction, chromosome, fitness, 0);
+}
+
+template <class T>
+Individual<T> GeneticAlgorithm<T>::solveMapped()
+{
+    const int n = populationSize;
+    vector<int> order(n), p1(mappedChunkSize), p2(mappedChunkSize), parentIndices;
+    vector<T> parents, offspring;
+    vector<double> fitness;
+    vector<RandomStream> offspringStreams;
+
+    for (;; generation++) // from 0, see startRun()
+    {
+        currentGeneration = (uint32_t)generation;
+        RandomStream stream;
+        RandomScope scope(randomStream(stream, generationDraws));
+
+        // Rank the individuals, the chromosomes stay in place.
+        for (int i = 0; i < n; i++)
+            order[i] = i;
+        sort(order.begin(), order.end(), [this](int a, int b) -> bool
+             {
+                 if (mappedFitness[a] != mappedFitness[b])
+                     return maximizeFitness ? mappedFitness[a] > mappedFitness[b] : mappedFitness[a] < mappedFitness[b];
+                 if (mappedAge[a] != mappedAge[b])
+                     return mappedAge[a] > mappedAge[b];
+                 // The same total order as comesBefore(), so a reproducible run ranks like the in-memory one
+                 return reproducible && memcmp(mappedPopulation.chromosome(a), mappedPopulation.chromosome(b), sizeof(T)) < 0; });
+        const double bestFitness = mappedFitness[order[0]];
+        {
+            T best;
+            memcpy(&best, mappedPopulation.chromosome(order[0]), sizeof(T));
+            bestSoFar.offer(best, bestFitness);
+        }
+
+        // Check termination conditions
+
+        if (generation == terminationConditions.maxGeneration)
+        {
+            if (verbose)
+                cout << "Done with best fitness: " << bestFitness << "\n";
+            return getMappedIndividual(order[0]);
+        }
+        if (isStopping())
+        {
+            stopRun();
+            return stoppedResult();
+        }
+        if (terminationConditions.checkFitnessGoalCondition(bestFitness))
+        {
+            if (verbose)
+                cout << "Reached to fitness goal: " << bestFitness << "\n";
+            return getMappedIndividual(order[0]);
+        }
+        if (terminationConditions.checkIterationsCondition(bestFitness))
+        {
+            if (verbose)
+                cout << "Reached to max iterations\n";
+            return getMappedIndividual(order[0]);
+        }
+
+        // Prepare parents' selection over the ranks.
+        elite = (ElitePercentage == 0) ? 0 : (int)ceil(ElitePercentage * n / 100);
+        goodRange = min((int)(1.5 * elite), n);
+        fitnessSum = 0;
+        fitnessValues.resize(n);
+        for (int i = 0; i < n; i++)
+        {
+            if (!isinf(mappedFitness[order[i]]))
+                fitnessSum += mappedFitness[order[i]];
+            fitnessValues[i] = fitnessSum;
+        }
+
+        // Move the elite to the start of the next generation.
+        mappedPopulation.adviseSequential(0, n, true);
+        for (int i = 0; i < elite; i++)
+        {
+            memcpy(mappedPopulation.chromosome(i, true), mappedPopulation.chromosome(order[i]), sizeof(T));
+            nextFitness[i] = mappedFitness[order[i]];
+            nextAge[i] = mappedAge[order[i]] + 1;
+        }
+
+        for (int first = elite; first < n; first += mappedChunkSize)
+        {
+            if (isStopping())
+            {
+                stopRun();
+                return stoppedResult(); // the current generation is untouched
+            }
+            const int count = min(mappedChunkSize, n - first);
+            parentIndices.clear();
+            offspringStreams.resize(count);
+            for (int i = 0; i < count; i++)
+            {
+                RandomScope offspringScope(randomStream(offspringStreams[i], first - elite + i));
+                selectParents(p1[i], p2[i]);
+                p1[i] = order[p1[i]];
+                p2[i] = order[p2[i]];
+                parentIndices.push_back(p1[i]);
+                parentIndices.push_back(p2[i]);
+            }
+
+            // Read the parents of the chunk once each, in file order.
+            sort(parentIndices.begin(), parentIndices.end());
+            parentIndices.erase(unique(parentIndices.begin(), parentIndices.end()), parentIndices.end());
+            parents.resize(parentIndices.size());
+            for (size_t k = 0; k < parentIndices.size(); k++)
+                memcpy(&parents[k], mappedPopulation.chromosome(parentIndices[k]), sizeof(T));
+
+            offspring.resize(count);
+            for (int i = 0; i < count; i++)
+            {
+                size_t a = lower_bound(parentIndices.begin(), parentIndices.end(), p1[i]) - parentIndices.begin();
+                size_t b = lower_bound(parentIndices.begin(), parentIndices.end(), p2[i]) - parentIndices.begin();
+                RandomScope offspringScope(reproducible ? &offspringStreams[i] : currentRandomStream()); // the draws go on after the selection
+                mate((byte *)&parents[a], (byte *)&parents[b], offspring[i]);
+            }
+            if (batchRepairFunctionStatus)
+                repairBlocks(offspring.data(), count, first - elite);
+            evaluateChromosomes(offspring, fitness);
+
+            for (int i = 0; i < count; i++)
+            {
+                memcpy(mappedPopulation.chromosome(first + i, true), &offspring[i], sizeof(T));
+                nextFitness[first + i] = isnan(fitness[i]) ? worstFitness() : fitness[i];
+                nextAge[first + i] = 0;
+                if (!isnan(fitness[i]))
+                    bestSoFar.offer(offspring[i], fitness[i]);
+            }
+            // The chunk is written, its pages can go back to the file.
+            mappedPopulation.adviseDontNeed(first, count, true);
+        }
+
+        mappedPopulation.swapGenerations();
+        mappedFitness.swap(nextFitness);
+        mappedAge.swap(nextAge);
+        if (verbose)
+        {
+            // The population is ranked at the start of the next generation, find its best here.
+            double best = mappedFitness[0];
+            for (int i = 1; i < n; i++)
+                if (maximizeFitness ? mappedFitness[i] > best : mappedFitness[i] < best)
+                    best = mappedFitness[i];
+            cout << "Generation: " << generation << "\tFitness: " << best << "\n";
+        }
+    }
+}
+
+template <class T>
+void GeneticAlgorithm<T>::computeStatistics()
+{
+    populationStatistics.reset(sizeof(T));
+    for (auto &individual : population)
+        populationStatistics.add(individual.getChromosomePointer(), individual.getFitness());
+}
+
+template <class T>
+bool GeneticAlgorithm<T>::stopRun()
+{
+    stopped = true;
+    if (verbose)
+        cout << ((cancellationToken && cancellationToken->isCancelled()) ? "Cancelled\n" : "Timeout\n");
+    return false;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::startRun()
+{
+    assert((!population.empty() || isMappedPopulation()) && "No population, use initializePopulation(size)");
+    if (verbose)
+        cout << "Start solving...\nMax Generation: " << terminationConditions.maxGeneration << "\n";
+
+    terminationConditions.isFirstTime = true;
+    terminationConditions.maximizeFitness = maximizeFitness;
+    terminationConditions.setStartTime();
+    bestSoFar.reset(maximizeFitness);
+    terminationConditions.resetSlope();
+    statsEvaluations = getEvaluationsCount();
+    trackingStatistics = isTrackingStatistics();
+    if (trackingStatistics)
+        computeStatistics();
+    generation = 0;
+    runStarted = true;
+    terminated = stopped = false;
+
+    if (isMappedPopulation())
+        return;
+
+    restartsCount = 0;
+    stagnation = 0;
+    hallOfFame.clear();
+    populationSorted = false;
+
+    if (surrogateScreeningStatus && archive.size() == 0)
+        for (auto &individual : population)
+            addToArchive(individual);
+
+    if (isMultiObjective())
+    {
+        evaluateObjectives(population);
+        selectNonDominated(population, populationSize);
+    }
+}
+
+template <class T>
+bool GeneticAlgorithm<T>::runGeneration()
+{
+    if (!traceWriter && !statsPage)
+        return runGeneration(nullptr);
+
+    GenerationRecord record;
+    record.generation = generation;
+    record.start_ns = traceNow_ns();
+    record.bestFitness = record.meanFitness = record.worstFitness = record.diversity = NAN;
+    record.rank_ns = record.localSearch_ns = record.breed_ns = record.dedup_ns = 0;
+    bool running = runGeneration(&record);
+    record.evaluations = getEvaluationsCount();
+    record.end_ns = traceNow_ns();
+    if (traceWriter)
+        traceWriter->push(record);
+    if (statsPage)
+        publishStats(record, running);
+    return running;
+}
+
+template <class T>
+void GeneticAlgorithm<T>::publishStats(GenerationRecord &record, bool running)
+{
+    StatsSnapshot &snapshot = statsSnapshot;
+    snapshot.generation = record.generation;
+    snapshot.evaluations = record.evaluations;
+    snapshot.meanFitness = record.meanFitness;
+    snapshot.diversity = record.diversity;
+    snapshot.elapsed_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::high_resolution_clock::now() - terminationConditions.startTime).count();
+    snapshot.state = running ? StatsRunning : (stopped ? StatsStopped : StatsFinished);
+    if (running || record.generation == 0) // the last generation only checks the termination conditions, keep the times of the previous one
+    {
+        snapshot.generation_ns = record.end_ns - record.start_ns;
+        snapshot.evaluationsPerSecond = snapshot.generation_ns > 0 ? (record.evaluations - statsEvaluations) * 1e9 / snapshot.generation_ns : 0;
+        snapshot.rank_ns = record.rank_ns;
+        snapshot.localSearch_ns = record.localSearch_ns;
+        snapshot.breed_ns = record.breed_ns;
+        snapshot.dedup_ns = record.dedup_ns;
+    }
+    statsEvaluations = record.evaluations;
+
+    T best;
+    if (!bestSoFar.read(best, snapshot.bestFitness)) // multi-objective: nothing published
+    {
+        memset(&best, 0, sizeof(T));
+        snapshot.bestFitness = record.bestFitness;
+    }
+    statsPage->publish(snapshot, &best);
+}
+
+template <class T>
+bool GeneticAlgorithm<T>::runGeneration(GenerationRecord *trace)
+{
+    currentGeneration = (uint32_t)generation;
+    RandomStream stream;
+    RandomScope scope(randomStream(stream, generationDraws));
+
+    trackingStatistics = isTrackingStatistics();
+    if (trackingStatistics && populationStatistics.size() != (int64_t)population.size())
+        computeStatistics();
+
+    int64_t t = trace ? trace->start_ns : 0;
+
+    // Sorting the population
+    sortPopulation();
+    tracePhase(trace, &GenerationRecord::rank_ns, t);
+    if (applyLocalSearch())
+        sortPopulation();
+    tracePhase(trace, &GenerationRecord::localSearch_ns, t);
+    if (!isMultiObjective())
+        publish(population[0]);
+    const double bestFitness = getPopulationBest().getFitness();
+    if (trace)
+    {
+        trace->bestFitness = bestFitness;
+        trace->worstFitness = population.back().getFitness();
+        if (trackingStatistics)
+        {
+            trace->meanFitness = populationStatistics.getMean();
+            trace->diversity = populationStatistics.getDiversity();
+        }
+    }
+
+    // Check termination conditions
+
+    if (generation == terminationConditions.maxGeneration)
+    {
+        if (verbose)
+            cout << "Done with best fitness: " << getBestIndividual().getFitness() << "\n";
+        return false;
+    }
+    if (isStopping())
+        return stopRun();
+    if (terminationConditions.checkFitnessGoalCondition(bestFitness))
+    {
+        if (verbose)
+            cout << "Reached to fitness goal: " << bestFitness << "\n";
+        return false;
+    }
+    if (terminationConditions.checkIterationsCondition(bestFitness))
+    {
+        if (verbose)
+            cout << "Reached to max iterations\n";
+        return false;
+    }
+    // The exact diversity of the allele counts, the one of the trace and the stats page; sampled in the multi-objective mode
+    if (terminationConditions.enableDiversity &&
+        terminationConditions.checkDiversityCondition(trackingStatistics ? populationStatistics.getDiversity() : getDiversity()))
+    {
+        if (verbose)
+            cout << "Reached to min diversity\n";
+        return false;
+    }
+    if (trackingStatistics && terminationConditions.checkFitnessBandCondition(populationStatistics.getMean(), populationStatistics.getStandardDeviation()))
+    {
+        if (verbose)
+            cout << "Reached to the fitness band: " << populationStatistics.getMean() << " +- " << populationStatistics.getStandardDeviation() << "\n";
+        return false;
+    }
+    if (!isMultiObjective() && terminationConditions.checkSlopeCondition(bestFitness))
+    {
+        if (verbose)
+            cout << "Reached to min improvement slope\n";
+        return false;
+    }
+    if (trackingStatistics && terminationConditions.enableAlleles &&
+        terminationConditions.checkAllelesCondition(populationStatistics.getConvergedAllelesFraction(terminationConditions.alleleThreshold)))
+    {
+        if (verbose)
+            cout << "Reached to max converged alleles\n";
+        return false;
+    }
+
+    if (checkRestart())
+    {
+        ++generation;
+        return true;
+    }
+    if (isStopping())
+        return stopRun();
+
+    vector<Individual<T>> newGeneration;
+    if (trackingStatistics)
+        nextStatistics.reset(sizeof(T));
+    if (trace)
+        t = traceNow_ns();
+
+    if (isMultiObjective())
+    {
+        // Parents and offspring compete for the next generation.
+        prepareFastSelection();
+        prepareRouletteWheelSelection();
+        breedOffspring(populationSize, newGeneration);
+        tracePhase(trace, &GenerationRecord::breed_ns, t);
+        if (isStopping())
+            return stopRun();
+        for (auto &individual : population)
+            individual.increaseAge();
+        population.insert(population.end(), newGeneration.begin(), newGeneration.end());
+        if (duplicateEliminationStatus)
+            eliminateDuplicates(population);
+        tracePhase(trace, &GenerationRecord::dedup_ns, t);
+        evaluateObjectives(population);
+        selectNonDominated(population, populationSize);
+        if (verbose)
+            cout << "Generation: " << generation << "\tPareto front: " << getParetoFront().size() << "\n";
+        ++generation;
+        return true;
+    }
+
+    int elite = getPercentageSize(ElitePercentage);
+    if (nichingStatus)
+        computeNiches();
+
+    if (kickOutAge == -1) // if kickOutAge is disabled
+        // Move the elite to the next generation.
+        for (int i = 0; i < elite; i++)
+        {
+            newGeneration.push_back(ranked(i));
+            newGeneration[i].increaseAge();
+            record(nextStatistics, newGeneration[i]);
+        }
+    else
+    {
+        // Move the young elite to the next generation.
+
+        int added = 0;
+        if (kickOutExceptBest || ranked(0).getAge() < kickOutAge || RANDOM(100) < 30) // Best one
+        {
+            newGeneration.push_back(ranked(0));
+            newGeneration[0].increaseAge();
+            record(nextStatistics, newGeneration[0]);
+            ++added;
         }
-        population = newGeneration;
-        cout << "Generation: " << generation << "\tFitness: " << population[0].getFitness() << "\n";
+
+        for (int i = 1; added < elite && i < populationSize; i++)
+            if (ranked(i).getAge() < kickOutAge || RANDOM(100) < 45)
+            {
+                newGeneration.push_back(ranked(i));
+                newGeneration[added].increaseAge();
+                record(nextStatistics, newGeneration[added]);
+                ++added;
+            }
+
+        /// Add new individuals if adders are less than elite to keep the population size the same.
+        vector<T> chromosomes;
+        for (int i = added; i < elite; i++)
+            chromosomes.push_back(generateRandomChromosome());
+        evaluateBatch(chromosomes, newGeneration);
+        for (int i = added; i < elite; i++)
+            record(nextStatistics, newGeneration[i]);
+    }
+
+    // Prepare parents' selection method.
+    switch (selection)
+    {
+    case Fast:
+        prepareFastSelection();
+        break;
+    case RouletteWheel:
+        prepareRouletteWheelSelection();
+        break;
+    case MixSelection:
+    default:
+        prepareFastSelection();
+        prepareRouletteWheelSelection();
+        break;
+    }
+
+    if (boundedFitnessFunctionStatus)
+        prepareCutoff();
+
+    breedOffspring(populationSize - elite, newGeneration);
+    tracePhase(trace, &GenerationRecord::breed_ns, t);
+    nicheOrder.clear();
+    if (isStopping())
+    {
+        populationSorted = false;
+        return stopRun();
+    }
+    if (duplicateEliminationStatus)
+    {
+        eliminateDuplicates(newGeneration, trackingStatistics ? &nextStatistics : nullptr);
+        populationSorted = false;
+        tracePhase(trace, &GenerationRecord::dedup_ns, t);
+    }
+
+    population.swap(newGeneration);
+    if (trackingStatistics)
+        swap(populationStatistics, nextStatistics);
+    if (verbose)
+        cout << "Generation: " << generation << "\tFitness: " << getPopulationBest().getFitness() << "\n";
+    ++generation;
+    return true;
+}
+
+template <class T>
+Individual<T> GeneticAlgorithm<T>::solve()
+{
+    startRun();
+    if (isMappedPopulation())
+    {
+        Individual<T> best = solveMapped();
+        terminated = true;
+        return best;
+    }
+
+    while (runGeneration())
+        ;
+    terminated = true;
+    return stopped ? stoppedResult() : getBestIndividual();
+}
+
+template <class T>
+Individual<T> GeneticAlgorithm<T>::step(uint64_t generations)
+{
+    assert((!isMappedPopulation()) && "step() does not support mapped populations, use solve()");
+    if (!runStarted)
+        startRun();
+
+    terminated = stopped = false;
+    for (uint64_t i = 0; i < generations && !terminated; i++)
+        terminated = !runGeneration();
+    if (stopped)
+        return stoppedResult();
+
+    // Rank the last offspring, the next generation does not sort them again.
+    sortPopulation();
+    populationSorted = true;
+    return getBestIndividual();
+}
+
+template <class T>
+void GeneticAlgorithm<T>::rescorePopulation(function<double(T &)> fitnessFunction)
+{
+    assert((fitnessFunction != nullptr && !population.empty()) && "No fitness function or no population");
+    this->fitnessFunction = fitnessFunction;
+
+    vector<T> chromosomes(population.size());
+    for (size_t i = 0; i < population.size(); i++)
+    {
+        chromosomes[i] = population[i].getChromosome();
+        if (chromosomeFixFunctionStatus && !batchRepairFunctionStatus)
+            chromosomeFixFunction(chromosomes[i]);
+    }
+    if (batchRepairFunctionStatus)
+        repairBlocks(chromosomes.data(), (int)chromosomes.size());
+    // Not evaluateChromosomes(): the evaluator pool and the asynchronous fitness function still score the old problem.
+    vector<double> fitness(chromosomes.size());
+    countEvaluations(chromosomes.size());
+    parallelFor((int)chromosomes.size(), [this, &chromosomes, &fitness](int i)
+                { fitness[i] = this->fitnessFunction(chromosomes[i]); });
+    trackingStatistics = isTrackingStatistics();
+    populationStatistics.reset(sizeof(T));
+    for (size_t i = 0; i < population.size(); i++)
+    {
+        population[i] = Individual<T>(fitnessFunction, chromosomes[i], fitness[i], population[i].getAge());
+        if (isnan(fitness[i]))
+            population[i].reject(worstFitness());
+        record(populationStatistics, population[i]);
+    }
+    if (isMultiObjective())
+        evaluateObjectives(population);
+
+    terminationConditions.isFirstTime = true;
+    terminationConditions.resetSlope();
+    bestSoFar.reset(maximizeFitness);
+    hallOfFame.clear();
+    stagnation = 0;
+    populationSorted = false;
+    if (surrogateScreeningStatus)
+    {
+        archive.reset(sizeof(T));
+        archiveFitness.clear();
+        archiveNext = 0;
+        for (auto &individual : population)
+            addToArchive(individual);
     }
 }
 
@@ -0,0 +1,106 @@
+/**
+ * @file Hamming.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief Hamming distance helpers and HammingIndex Class are a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef HAMMING_H
+#define HAMMING_H
+
+#include <stdint.h>
+#include <vector>
+#include <unordered_map>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+using namespace std;
+
+inline int popcount64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return (int)__popcnt64(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Number of different bits between two packed chromosomes of %words% 64-bit words
+inline int hammingDistance(const uint64_t *a, const uint64_t *b, int words)
+{
+    int d = 0;
+    for (int i = 0; i < words; i++)
+        d += popcount64(a[i] ^ b[i]);
+    return d;
+}
+
+/**
+ * @brief Nearest neighbour index over chromosomes in Hamming space, using bit-sampling locality-sensitive hashing.
+ * Each table hashes a chromosome by a fixed random sample of its bits, so close chromosomes share buckets.
+ */
+class HammingIndex
+{
+public:
+    /**
+     * @brief Construct a new Hamming Index object
+     *
+     * @param chromosomeSize the size of the chromosome in bytes
+     * @param tablesCount number of hash tables, more tables find more neighbours
+     * @param sampledBits number of sampled bits per table, put 0 to choose it from the chromosome size
+     */
+    HammingIndex(int chromosomeSize = 0, int tablesCount = 8, int sampledBits = 0);
+    void reset(int chromosomeSize, int tablesCount = 8, int sampledBits = 0);
+
+    // Add a chromosome and return its id
+    int insert(const uint8_t *chromosome);
+    // Replace the chromosome stored under %id%
+    void replace(int id, const uint8_t *chromosome);
+    void clear();
+    int size() { return count; }
+    // Number of nearest() queries that scanned the whole index
+    uint64_t getLinearScansCount() { return linearScansCount; }
+
+    /**
+     * @brief Find the k nearest chromosomes among the candidates of the buckets of the chromosome. When they are less than k,
+     * the buckets whose key differs in one sampled bit are probed too, then in two bits (multi-probe), and the whole index is
+     * scanned only if that is still not enough or if probing would cost more than the scan.
+     *
+     * @param[out] neighbours (distance, id) pairs sorted by distance
+     */
+    void nearest(const uint8_t *chromosome, int k, vector<pair<int, int>> &neighbours);
+    /**
+     * @brief Find the chromosomes within %radius% bits, among the ones that share a bucket (no linear scan, close chromosomes can be missed)
+     *
+     * @param[out] neighbours (distance, id) pairs sorted by distance
+     */
+    void within(const uint8_t *chromosome, int radius, vector<pair<int, int>> &neighbours);
+
+private:
+    int chromosomeSize, words, tablesCount, sampledBits, count;
+    vector<uint64_t> chromosomes;
+    vector<vector<int>> sampledPositions;
+    vector<unordered_map<uint64_t, vector<int>>> buckets;
+    vector<uint64_t> query, queryKeys; // the packed query and its key in each table
+    vector<int> visited;
+    int visitStamp;
+    uint64_t linearScansCount;
+
+    void pack(const uint8_t *chromosome, uint64_t *packed);
+    uint64_t key(int table, const uint64_t *packed);
+    void addToBuckets(int id);
+    void removeFromBuckets(int id);
+    // The chromosomes within %radius% bits that share a bucket with %chromosome%, unsorted
+    void bucketNeighbours(const uint8_t *chromosome, int radius, vector<pair<int, int>> &neighbours);
+    // Add the chromosomes of bucket %key% of %table% not visited yet by this query, within %radius% bits of it
+    void probe(int table, uint64_t key, int radius, vector<pair<int, int>> &neighbours);
+};
+
+#endif
@@ -15,11 +15,15 @@
 #include <vector>
 #include <functional>
 #include <cassert>
+#include <math.h>
 
 using namespace std;
 
 typedef unsigned char byte;
 
+// Returned by a bounded fitness function when the chromosome can not beat the cutoff
+#define REJECTED_FITNESS (NAN)
+
 template <class T>
 class Individual
 {
@@ -46,16 +50,58 @@ public:
         computeFitness();
         setAge(age);
     }
+    /**
+     * @brief Construct a new Individual object with an already known fitness (the fitness function is not called)
+     *
+     * @param fitnessFunction defines by user 'double fitness(T& chromosome)'
+     * @param initialChromosome
+     * @param fitness the fitness of initialChromosome
+     * @param age
+     */
+    Individual(function<double(T &)> fitnessFunction, T &initialChromosome, double fitness, uint64_t age)
+    {
+        this->fitnessFunction = fitnessFunction;
+        this->chromosome = initialChromosome;
+        this->fitness = fitness;
+        rejected = false;
+        learned = false;
+        setAge(age);
+    }
     ~Individual() {}
 
-    double getFitness()
+    double getFitness() const
     {
         return fitness;
     }
+    void setFitness(double fitness)
+    {
+        this->fitness = fitness;
+        learned = false;
+    }
 
     void computeFitness()
     {
         fitness = fitnessFunction(chromosome);
+        rejected = false;
+        learned = false;
+    }
+
+    // The fitness that ranks the individual: the fitness of its improved chromosome after a Baldwinian local search, else its fitness
+    double getLearnedFitness() const { return learned ? learnedFitness : fitness; }
+    void setLearnedFitness(double learnedFitness)
+    {
+        this->learnedFitness = learnedFitness;
+        learned = true;
+    }
+    bool hasLearnedFitness() const { return learned; }
+
+    // Rejected individuals hold the worst possible fitness and take no part in Roulette Wheel selection
+    bool isRejected() { return rejected; }
+    void reject(double worstFitness)
+    {
+        fitness = worstFitness;
+        rejected = true;
+        learned = false;
     }
 
     byte *getChromosomePointer()
@@ -67,16 +113,25 @@ public:
     {
         return chromosome;
     }
+    void setChromosome(const T &chromosome)
+    {
+        this->chromosome = chromosome;
+        learned = false;
+    }
+
+    // Objectives of the multi-objective mode, empty until evaluated
+    vector<double> &getObjectives() { return objectives; }
+    void setObjectives(const vector<double> &objectives) { this->objectives = objectives; }
 
-    uint64_t getAge() { return age; }
+    uint64_t getAge() const { return age; }
     void setAge(uint64_t age) { this->age = age; }
     void increaseAge() { ++age; }
 
-    bool operator<(Individual b)
+    bool operator<(const Individual &b) const
     {
-        if (getFitness() > b.getFitness())
+        if (getLearnedFitness() > b.getLearnedFitness())
             return true;
-        if (getFitness() < b.getFitness())
+        if (getLearnedFitness() < b.getLearnedFitness())
             return false;
         return getAge() > b.getAge();
     }
@@ -84,8 +139,10 @@ public:
 protected:
     function<double(T &)> fitnessFunction;
     T chromosome;
-    double fitness;
+    double fitness, learnedFitness;
+    bool rejected, learned;
     uint64_t age;
+    vector<double> objectives;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+/**
+ * @file MappedPopulation.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief MappedPopulation Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef MAPPEDPOPULATION_H
+#define MAPPEDPOPULATION_H
+
+#include <stdint.h>
+#include <string>
+using namespace std;
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_POPULATION_FILES 1
+#else
+#define MAPPED_POPULATION_FILES 0
+#endif
+
+/**
+ * @brief Chromosome storage for populations larger than the memory, kept in a memory-mapped file.
+ * The file holds two generations of chromosomes one after another: the current one is read while the next one is written.
+ * @note Without mmap (not POSIX), the chromosomes are kept in memory.
+ */
+class MappedPopulation
+{
+public:
+    MappedPopulation();
+    ~MappedPopulation();
+
+    /**
+     * @brief Create (or overwrite) the file and map it
+     *
+     * @param path the file of the chromosomes, its size becomes 2 * count * chromosomeSize bytes
+     * @param count number of chromosomes per generation
+     * @param chromosomeSize the size of the chromosome in bytes
+     * @return false if the file can not be created or mapped
+     */
+    bool open(const string &path, int64_t count, int chromosomeSize);
+    // Unmap and close the file, the file itself is kept
+    void close();
+    bool isOpen() { return data != nullptr; }
+
+    int64_t size() { return count; }
+    int getChromosomeSize() { return chromosomeSize; }
+
+    // The chromosome %index% of the current generation (%next% = false) or the next generation (%next% = true)
+    uint8_t *chromosome(int64_t index, bool next = false)
+    {
+        return data + ((int64_t)(current ^ next) * count + index) * chromosomeSize;
+    }
+    // The next generation becomes the current one
+    void swapGenerations() { current ^= 1; }
+
+    // Access hints for the chromosomes [first, first + count[, they do not change the content
+    void adviseSequential(int64_t first, int64_t count, bool next = false);
+    void adviseRandom(int64_t first, int64_t count, bool next = false);
+    void adviseWillNeed(int64_t first, int64_t count, bool next = false);
+    // The chromosomes are not needed soon, their pages can leave the memory (written back to the file first)
+    void adviseDontNeed(int64_t first, int64_t count, bool next = false);
+
+private:
+    uint8_t *data;
+    int64_t count;
+    int chromosomeSize;
+    int current;
+    size_t length;
+    int fd;
+
+    void advise(int64_t first, int64_t count, bool next, int advice);
+};
+
+#endif
@@ -0,0 +1,38 @@
+/**
+ * @file MultiObjective.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief Non-dominated sorting and crowding distance are a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef MULTIOBJECTIVE_H
+#define MULTIOBJECTIVE_H
+
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Sort points into non-dominated fronts, all objectives are minimized
+ * @note Time complexity: O(n log n) for 2 objectives, O(n log^2 n) for 3 objectives, O(m n^2) in the worst case for more objectives,
+ * where n is the number of points and m is the number of objectives
+ *
+ * @param objectives objectives[i] is the objectives vector of point i, all vectors have the same size
+ * @param[out] rank rank[i] is the front of point i, 0 is the Pareto front
+ * @return the number of fronts
+ */
+int nonDominatedSort(const vector<vector<double>> &objectives, vector<int> &rank);
+
+/**
+ * @brief Compute the crowding distance of the members of one front, the boundary points get infinity
+ * @note Time complexity: O(m k log k), where k is the number of members
+ *
+ * @param objectives objectives[i] is the objectives vector of point i
+ * @param members the points of the front
+ * @param[out] distance distance[i] is the crowding distance of point i, only the members are written
+ */
+void crowdingDistance(const vector<vector<double>> &objectives, const vector<int> &members, vector<double> &distance);
+
+#endif
@@ -0,0 +1,48 @@
+/**
+ * @file NumaTopology.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief NumaTopology Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef NUMATOPOLOGY_H
+#define NUMATOPOLOGY_H
+
+#include <string>
+#include <vector>
+#include <thread>
+using namespace std;
+
+/**
+ * @brief The NUMA nodes of the machine and the CPUs of each one, read from /sys/devices/system/node (Linux).
+ * Without them (single node, other systems) there is one node with every CPU the process may use.
+ */
+class NumaTopology
+{
+public:
+    NumaTopology();
+
+    int nodesCount() const { return (int)nodes.size(); }
+    const vector<int> &getCpus(int node) const { return nodes[node]; }
+    // The node of %cpu%, -1 if it is not usable
+    int getNode(int cpu) const;
+
+    /**
+     * @brief The CPU of each of %threadsCount% threads: the threads are split evenly over the nodes,
+     * consecutive threads on the same node, one CPU each as long as the node has enough of them
+     */
+    vector<int> place(int threadsCount) const;
+
+    // Pin %worker% to %cpu%, return false when it is not possible (or not supported)
+    static bool pin(thread &worker, int cpu);
+    // Parse a CPU list of the kernel, like "0-3,8,10-11"
+    static vector<int> parseCpuList(const string &list);
+
+private:
+    vector<vector<int>> nodes; // usable CPUs of each node, the empty nodes are left out
+};
+
+#endif
@@ -0,0 +1,76 @@
+/**
+ * @file OperatorSelector.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief OperatorSelector Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef OPERATORSELECTOR_H
+#define OPERATORSELECTOR_H
+
+#include <stdint.h>
+#include <vector>
+using namespace std;
+
+enum Adaptation
+{
+    ProbabilityMatching,
+    MultiArmedBandit
+};
+
+struct OperatorStats
+{
+    uint64_t uses = 0;         // number of offspring produced by the operator (selections)
+    uint64_t credits = 0;      // number of its offspring evaluated and credited so far
+    uint64_t improvements = 0; // number of offspring better than their best parent
+    double reward = 0;         // sum of the normalized rewards
+    double quality = 0;        // mean reward (bandit), or recency-weighted average reward (probability matching)
+    double probability = 0;    // current probability to select the operator (share of the selections for the bandit)
+};
+
+/**
+ * @brief Choose between several operators and shift the choice toward the operators that produce improving offspring.
+ * The reward of an offspring is its fitness improvement over its best parent, normalized by the largest improvement seen so far.
+ */
+class OperatorSelector
+{
+public:
+    /**
+     * @brief Reset the selector
+     *
+     * @param initialProbabilities the fixed probabilities used before any reward, one per operator
+     * @param adaptation 'ProbabilityMatching' (select with probabilities proportional to the qualities)
+     * or 'MultiArmedBandit' (select the operator with the highest upper confidence bound, UCB1 on the mean rewards)
+     * @param minProbability the lowest probability of any operator (probability matching)
+     * @param adaptationRate weight of the newest reward in the quality of probability matching, in ]0, 1]
+     */
+    void reset(const vector<double> &initialProbabilities, Adaptation adaptation = ProbabilityMatching, double minProbability = 0.05, double adaptationRate = 0.02);
+
+    /**
+     * @brief Select an operator, counted as a use at once: when a whole generation is selected before its offspring
+     * are credited, the bandit still spreads the pending selections over the operators.
+     *
+     * @param random a uniform random number in [0, 1[
+     * @return the index of the operator
+     */
+    int select(double random);
+    // Credit operator %index% with the improvement of its offspring (<= 0 for no improvement)
+    void credit(int index, double improvement);
+
+    vector<OperatorStats> &getStats() { return stats; }
+
+private:
+    vector<OperatorStats> stats;
+    Adaptation adaptation;
+    double minProbability;
+    double adaptationRate;
+    double maxImprovement;
+    uint64_t totalUses;
+
+    void updateProbabilities();
+};
+
+#endif
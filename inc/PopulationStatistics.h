@@ -0,0 +1,53 @@
+/**
+ * @file PopulationStatistics.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief PopulationStatistics Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef POPULATIONSTATISTICS_H
+#define POPULATIONSTATISTICS_H
+
+#include <stdint.h>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Fitness mean and variance (Welford) and allele counts of a population, updated one individual at a time
+ * while the individuals are evaluated, so no extra pass over the population is needed.
+ * @note Non-finite fitness (rejected individuals) is left out of the fitness moments, their chromosomes are still counted.
+ */
+class PopulationStatistics
+{
+public:
+    PopulationStatistics(int chromosomeSize = 0) { reset(chromosomeSize); }
+
+    void reset(int chromosomeSize);
+    void add(const uint8_t *chromosome, double fitness);
+    void remove(const uint8_t *chromosome, double fitness);
+    // Add the individuals counted by %other% (same chromosome size)
+    void merge(const PopulationStatistics &other);
+
+    // Number of chromosomes
+    int64_t size() const { return count; }
+    double getMean() const { return mean; }
+    double getVariance() const { return fitnessCount > 1 ? m2 / fitnessCount : 0; }
+    double getStandardDeviation() const;
+    // Frequency of the allele 1 at bit %bit% of the chromosome
+    double getAlleleFrequency(int bit) const { return count ? (double)ones[bit] / count : 0; }
+    // Fraction of the bits where at least %threshold% of the chromosomes hold the same allele
+    double getConvergedAllelesFraction(double threshold = 0.95) const;
+    // Mean pairwise Hamming distance / chromosome bits, exact, from the allele counts
+    double getDiversity() const;
+
+private:
+    int chromosomeSize;
+    int64_t count, fitnessCount;
+    double mean, m2;
+    vector<int64_t> ones; // number of 1 alleles per bit
+};
+
+#endif
@@ -0,0 +1,108 @@
+/**
+ * @file Random.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief Counter-based random numbers are a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * @brief Philox4x32-10 block function (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", SC 2011)
+ *
+ * @param counter the 128-bit counter
+ * @param key the 64-bit key
+ * @param[out] output 128 random bits
+ */
+inline void philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t output[4])
+{
+    uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; round++)
+    {
+        uint64_t p0 = (uint64_t)0xD2511F53 * c0;
+        uint64_t p1 = (uint64_t)0xCD9E8D57 * c2;
+        c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        c1 = (uint32_t)p1;
+        c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c3 = (uint32_t)p0;
+        k0 += 0x9E3779B9;
+        k1 += 0xBB67AE85;
+    }
+    output[0] = c0;
+    output[1] = c1;
+    output[2] = c2;
+    output[3] = c3;
+}
+
+/**
+ * @brief Random numbers of the stream (seed, generation, index): the draw number n is a pure function of the four values,
+ * so a stream gives the same numbers on any thread and can be replayed on its own.
+ */
+class RandomStream
+{
+public:
+    RandomStream(uint64_t seed = 0, uint32_t generation = 0, uint32_t index = 0) { reset(seed, generation, index); }
+
+    void reset(uint64_t seed, uint32_t generation, uint32_t index)
+    {
+        key[0] = (uint32_t)seed;
+        key[1] = (uint32_t)(seed >> 32);
+        counter[0] = counter[1] = 0; // the draw index
+        counter[2] = index;
+        counter[3] = generation;
+        used = 4;
+    }
+
+    uint32_t next()
+    {
+        if (used == 4)
+        {
+            philox4x32(counter, key, block);
+            if (++counter[0] == 0)
+                ++counter[1];
+            used = 0;
+        }
+        return block[used++];
+    }
+
+private:
+    uint32_t key[2], counter[4], block[4];
+    int used;
+};
+
+// The stream of the calling thread, nullptr to use rand()
+inline RandomStream *&currentRandomStream()
+{
+    static thread_local RandomStream *stream = nullptr;
+    return stream;
+}
+
+// The next random number of the calling thread, in [0, 2^31[
+inline uint32_t randomNext()
+{
+    RandomStream *stream = currentRandomStream();
+    return stream ? stream->next() >> 1 : (uint32_t)rand();
+}
+
+// Make %stream% the stream of the calling thread until the end of the scope
+class RandomScope
+{
+public:
+    RandomScope(RandomStream *stream) : previous(currentRandomStream()) { currentRandomStream() = stream; }
+    ~RandomScope() { currentRandomStream() = previous; }
+
+private:
+    RandomStream *previous;
+    RandomScope(const RandomScope &);
+    RandomScope &operator=(const RandomScope &);
+};
+
+#endif
@@ -0,0 +1,153 @@
+/**
+ * @file Repair.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief Chromosome repair helpers are a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef REPAIR_H
+#define REPAIR_H
+
+#include "Random.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+/**
+ * @brief Scratch memory for the repair functions: allocate() takes memory from a reusable buffer, reset() gives all of it back at once.
+ * After the first blocks the buffer is big enough and nothing is allocated anymore.
+ * @note The memory is not initialized and no destructor is called, use it for plain types.
+ */
+class ScratchArena
+{
+public:
+    ScratchArena(size_t capacity = 1 << 16) : blocks(1, vector<uint8_t>(capacity)), used(0) {}
+
+    // Memory for %count% values of type U
+    template <class U>
+    U *allocate(size_t count) { return (U *)allocate(count * sizeof(U), alignof(U)); }
+
+    void *allocate(size_t bytes, size_t alignment)
+    {
+        size_t offset = (used + alignment - 1) & ~(alignment - 1);
+        if (offset + bytes > blocks.back().size())
+        {
+            // The old blocks stay valid until reset().
+            blocks.push_back(vector<uint8_t>(max(2 * blocks.back().size(), bytes + alignment)));
+            offset = (alignment - (uintptr_t)blocks.back().data() % alignment) % alignment;
+        }
+        used = offset + bytes;
+        return blocks.back().data() + offset;
+    }
+
+    // Free everything allocated so far
+    void reset()
+    {
+        if (blocks.size() > 1)
+        {
+            // Keep one block as large as all of them, the next round fits in it.
+            size_t capacity = 0;
+            for (auto &block : blocks)
+                capacity += block.size();
+            blocks.clear();
+            blocks.push_back(vector<uint8_t>(capacity));
+        }
+        used = 0;
+    }
+
+    size_t capacity() { return blocks.back().size(); }
+
+private:
+    vector<vector<uint8_t>> blocks;
+    size_t used; // in the last block
+};
+
+// The arena of the calling thread
+inline ScratchArena &threadScratchArena()
+{
+    static thread_local ScratchArena arena;
+    return arena;
+}
+
+/**
+ * @brief Make genes[0..count[ a permutation of 0..count-1 (like a tour of the traveling salesman): every gene is taken modulo count,
+ * then the repeated values are replaced by the missing ones, in random order, and a random occurrence of each repeated value is kept.
+ * @note O(count) time, the memory comes from %arena%. The random numbers come from RANDOM (the stream of the offspring in reproducible mode).
+ */
+template <class G>
+void repairPermutation(G *genes, int count, ScratchArena &arena)
+{
+    int *occurrences = arena.allocate<int>(count);
+    int *missing = arena.allocate<int>(count);
+    for (int v = 0; v < count; v++)
+        occurrences[v] = 0;
+    for (int i = 0; i < count; i++)
+    {
+        long long v = (long long)genes[i] % count;
+        if (v < 0)
+            v += count;
+        genes[i] = (G)v;
+        ++occurrences[v];
+    }
+
+    // occurrences[v] becomes the occurrence of v to keep, counted down while scanning (-1: already kept or missing).
+    int missingCount = 0;
+    for (int v = 0; v < count; v++)
+        if (occurrences[v] == 0)
+        {
+            missing[missingCount++] = v;
+            occurrences[v] = -1;
+        }
+        else
+            occurrences[v] = (int)(randomNext() % (uint32_t)occurrences[v]);
+    if (missingCount == 0)
+        return;
+
+    for (int i = missingCount - 1; i > 0; i--) // shuffle
+    {
+        int j = (int)(randomNext() % (uint32_t)(i + 1));
+        int tmp = missing[i];
+        missing[i] = missing[j];
+        missing[j] = tmp;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        int &keep = occurrences[(int)genes[i]];
+        if (keep == 0)
+            keep = -1;
+        else
+        {
+            if (keep > 0)
+                --keep;
+            genes[i] = (G)missing[--missingCount];
+        }
+    }
+}
+
+// Clamp every gene into [low, high]
+template <class G>
+void clampGenes(G *genes, int count, G low, G high)
+{
+    for (int i = 0; i < count; i++)
+        genes[i] = genes[i] < low ? low : (high < genes[i] ? high : genes[i]);
+}
+
+// Wrap every integer gene into [low, high] (modulo the width of the range), random genes stay uniform when the width divides their range
+template <class G>
+void wrapGenes(G *genes, int count, G low, G high)
+{
+    const long long width = (long long)high - (long long)low + 1;
+    for (int i = 0; i < count; i++)
+    {
+        long long v = ((long long)genes[i] - (long long)low) % width;
+        genes[i] = (G)(low + (v < 0 ? v + width : v));
+    }
+}
+
+#endif
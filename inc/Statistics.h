@@ -0,0 +1,37 @@
+/**
+ * @file Statistics.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief Statistical tests are a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include <vector>
+using namespace std;
+
+// Quantile of the standard normal distribution, p in ]0, 1[ (Abramowitz and Stegun 26.2.23, error < 4.5e-4)
+double normalQuantile(double p);
+// Quantile of Student's t distribution with %df% degrees of freedom (Cornish-Fisher expansion, exact for df = 1, 2)
+double studentQuantile(double p, double df);
+// Quantile of the chi-square distribution with %df% degrees of freedom (Wilson-Hilferty)
+double chiSquareQuantile(double p, double df);
+
+/**
+ * @brief One step of F-race (Birattari et al. 2002): Friedman test over k configurations measured on n blocks,
+ * then post-hoc comparisons of every configuration with the best one
+ * @note Time complexity: O(n k log k)
+ *
+ * @param results results[i][j] is the result of configuration j on block i, lower is better
+ * @param alpha significance level
+ * @param[out] eliminated eliminated[j] is true when configuration j is worse than the best one
+ * @param[out] meanRanks the mean rank of each configuration over the blocks, 1 is the best
+ * @return true if the Friedman test rejects the hypothesis that all configurations are equal
+ */
+bool friedmanRace(const vector<vector<double>> &results, double alpha, vector<bool> &eliminated, vector<double> &meanRanks);
+
+#endif
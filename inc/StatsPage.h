@@ -0,0 +1,121 @@
+/**
+ * @file StatsPage.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief StatsPage Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef STATSPAGE_H
+#define STATSPAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <atomic>
+#include <chrono>
+using namespace std;
+
+#if defined(__unix__) || defined(__APPLE__)
+#define STATS_PAGE_SHM 1
+#else
+#define STATS_PAGE_SHM 0
+#endif
+
+enum StatsState
+{
+    StatsRunning,
+    StatsFinished, // a termination condition is reached
+    StatsStopped   // cancelled or timed out
+};
+
+// The live statistics of a run, 8-byte fields only so the layout is the same for every compiler
+struct StatsSnapshot
+{
+    uint64_t generation;
+    uint64_t evaluations;         // fitness evaluations so far
+    double evaluationsPerSecond;  // during the last generation
+    double bestFitness;           // of the best chromosome so far (the chromosome of the page)
+    double meanFitness;           // of the population
+    double diversity;             // mean pairwise Hamming distance / chromosome bits
+    int64_t elapsed_ns;           // since the run started
+    int64_t generation_ns;        // the last generation
+    int64_t rank_ns;              // phase times of the last generation, see GenerationRecord
+    int64_t localSearch_ns;
+    int64_t breed_ns;
+    int64_t dedup_ns;
+    uint64_t state;               // StatsState
+};
+
+/**
+ * @brief A page of live statistics in a POSIX shared-memory segment: the solver publishes a snapshot and the best chromosome
+ * at the end of each generation, and monitors in other processes (tools/ga_monitor) read it at any moment.
+ *
+ * The page is a fixed header ("GASTATS1", version, chromosome size, pid, sequence) followed by the snapshot and the chromosome,
+ * stored as 64-bit words. Writing is a seqlock: the sequence is odd during an update, readers retry until they copy the words
+ * between two equal even values, so the solver never waits for them and publishing costs a few stores.
+ * @note One thread publishes. Without shared memory (not POSIX), create() and attach() fail.
+ */
+class StatsPage
+{
+public:
+    StatsPage();
+    // The writer removes the segment
+    ~StatsPage();
+
+    /**
+     * @brief Create (or replace) the segment %name% and map it, for the writer
+     *
+     * @param name the name of the segment, like "/ga_stats" (see shm_open)
+     * @param chromosomeSize the size of the chromosome in bytes
+     */
+    bool create(const string &name, int chromosomeSize);
+    // Map the existing segment %name% read-only, for a monitor, false if it is not a stats page
+    bool attach(const string &name);
+    void close();
+    bool isOpen() { return page != nullptr; }
+
+    // Write a new snapshot and best chromosome (chromosomeSize bytes)
+    void publish(const StatsSnapshot &snapshot, const void *chromosome);
+    /**
+     * @brief Read a consistent copy of the page, lock-free
+     *
+     * @param[out] chromosome getChromosomeSize() bytes, may be nullptr
+     * @param[out] version the number of snapshots published so far
+     * @return false if nothing is published yet, or if the writer stays in the middle of an update (it died while writing)
+     */
+    bool read(StatsSnapshot &snapshot, void *chromosome = nullptr, uint64_t *version = nullptr) const;
+
+    int getChromosomeSize() { return chromosomeSize; }
+    // The process id of the writer
+    uint64_t getWriterPid();
+    string getName() { return name; }
+    // Nanoseconds since the page is created, a time base for the phase times
+    int64_t now_ns() { return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - startTime).count(); }
+
+private:
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t chromosomeSize;
+        uint64_t pid;
+        atomic<uint64_t> sequence; // odd while the writer updates the page
+    };
+    static const int snapshotWords = sizeof(StatsSnapshot) / 8;
+
+    Header *page;
+    atomic<uint64_t> *words; // the snapshot, then the chromosome
+    int chromosomeSize, chromosomeWords;
+    size_t length;
+    string name;
+    bool writer;
+    chrono::steady_clock::time_point startTime;
+
+    StatsPage(const StatsPage &);
+    StatsPage &operator=(const StatsPage &);
+};
+
+#endif
@@ -12,6 +12,8 @@
 #define TERMINATIONCONDITIONS_H
 
 #include <chrono>
+#include <vector>
+#include <stdint.h>
 using namespace std;
 
 class TerminationConditions
@@ -25,13 +27,28 @@ public:
     void setMaxIterations(uint64_t maxIterations);
     // Terminate the solving process after reaching %maxGeneration%, put -1 for infinite generations
     void setMaxGeneration(uint64_t maxGeneration);
+    // Terminate the solving process when the population diversity (mean pairwise Hamming distance / chromosome bits) falls below %minDiversity%
+    void setMinDiversity(double minDiversity);
+    // Terminate the solving process when the fitness standard deviation of the population falls below %relativeWidth% * |mean fitness|
+    void setFitnessBand(double relativeWidth);
+    // Terminate the solving process when the least-squares slope of the best fitness over the last %window% generations
+    // (improvement per generation) falls below %minSlope%
+    void setMinImprovementSlope(double minSlope, uint64_t window = 50);
+    // Terminate the solving process when at least %fraction% of the chromosome bits are converged (at least %threshold% of the population holds the same allele)
+    void setMaxConvergedAlleles(double fraction, double threshold = 0.95);
 
     bool enableGool = false;
     bool enableTime = false;
     bool enableIterations = false;
+    bool enableDiversity = false;
+    bool enableFitnessBand = false;
+    bool enableSlope = false;
+    bool enableAlleles = false;
 
     template <class T>
     friend class GeneticAlgorithm;
+    template <class T, class G>
+    friend class DifferentialEvolution;
 
 private:
     double goal;
@@ -42,6 +59,14 @@ private:
     double lastFitness;
     bool isFirstTime = true;
     uint64_t maxGeneration = 200;
+    double minDiversity;
+    double relativeWidth;
+    double minSlope;
+    uint64_t slopeWindow;
+    vector<double> slopeValues; // ring buffer of the best fitness
+    size_t slopeNext;
+    double slopeSumY, slopeSumXY; // x is the position in the window, the oldest is 0
+    double convergedFraction, alleleThreshold;
     chrono::high_resolution_clock::time_point startTime = chrono::high_resolution_clock::now();
 
     void setStartTime(chrono::high_resolution_clock::time_point startTime);
@@ -49,6 +74,12 @@ private:
     bool checkTimeCondition();
     bool checkFitnessGoalCondition(double bestFitness);
     bool checkIterationsCondition(double bestFitness);
+    bool checkDiversityCondition(double diversity);
+    bool checkFitnessBandCondition(double mean, double standardDeviation);
+    bool checkSlopeCondition(double bestFitness);
+    bool checkAllelesCondition(double convergedFraction);
+    // Forget the best fitness of the previous generations (new run or new population)
+    void resetSlope();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,62 @@
+/**
+ * @file ThreadPool.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief ThreadPool Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <string>
+using namespace std;
+
+class ThreadPool
+{
+public:
+    /**
+     * @brief Construct a new Thread Pool object
+     *
+     * @param threadsCount number of threads including the calling thread, put 0 to use all hardware threads
+     * @param pinThreads pin the pool threads to CPUs spread evenly over the NUMA nodes (see NumaTopology), the memory they touch first
+     * (their scratch buffers) is then allocated on their node
+     */
+    ThreadPool(int threadsCount = 0, bool pinThreads = false);
+    ~ThreadPool();
+
+    // Number of threads including the calling thread
+    int size() { return (int)workers.size() + 1; }
+
+    /**
+     * @brief Run task(i) for every i in [begin, end[ on the pool and the calling thread, and wait for all of them
+     * @note It can be called from inside a task, the calling thread keeps working until every index is taken.
+     */
+    void parallelFor(int begin, int end, function<void(int)> task);
+
+    // Run a task on one of the pool threads without waiting for it
+    void submit(function<void()> task);
+
+    // The NUMA nodes and the CPU of each thread, empty when the threads are not pinned
+    string getPlacement() { return placement; }
+
+private:
+    vector<thread> workers;
+    queue<function<void()>> tasks;
+    mutex tasksMutex;
+    condition_variable tasksCondition;
+    bool stopping;
+    string placement;
+
+    void workerLoop();
+};
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * @file TraceWriter.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief TraceWriter Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef TRACEWRITER_H
+#define TRACEWRITER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+using namespace std;
+
+// Telemetry of one generation, written as is (96 bytes, little-endian on the usual machines) in the binary trace
+struct GenerationRecord
+{
+    uint64_t generation;
+    int64_t start_ns, end_ns; // since the trace is opened
+    double bestFitness, meanFitness, worstFitness;
+    double diversity;     // mean pairwise Hamming distance / chromosome bits, NaN without the population statistics
+    uint64_t evaluations; // fitness evaluations so far
+    // Phase times
+    int64_t rank_ns;        // sorting the population
+    int64_t localSearch_ns; // memetic local search
+    int64_t breed_ns;       // selection, crossover, mutation and evaluation of the offspring
+    int64_t dedup_ns;       // duplicate elimination
+};
+
+enum TraceFormat
+{
+    TraceBinary, // "GATRACE1", uint32 version, uint32 record size, then the records
+    TraceCSV
+};
+
+/**
+ * @brief Per-generation trace of a run: the solving thread puts each record in a preallocated ring buffer (lock-free, no allocation,
+ * no system call), and a background thread writes the buffer to the file.
+ * @note One thread pushes the records. When the buffer is full the record is dropped and counted, the solving thread never waits.
+ */
+class TraceWriter
+{
+public:
+    /**
+     * @brief Create (or overwrite) the trace file and start the writing thread
+     *
+     * @param capacity number of records in the ring buffer
+     * @param flushInterval_ms time between two writes of the buffer
+     */
+    TraceWriter(const string &path, TraceFormat format = TraceBinary, int capacity = 4096, double flushInterval_ms = 100);
+    // Write the remaining records and close the file
+    ~TraceWriter();
+
+    bool isOpen() { return file != nullptr; }
+    // Add a record, return false if it is dropped
+    bool push(const GenerationRecord &record);
+    // Wait until every pushed record is written to the file
+    void flush();
+    uint64_t getDroppedCount() { return dropped.load(memory_order_relaxed); }
+    // Nanoseconds since the trace is opened, the time base of the records
+    int64_t now_ns() { return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - startTime).count(); }
+
+    // Read a binary trace, return false if the file is not a trace
+    static bool read(const string &path, vector<GenerationRecord> &records);
+
+private:
+    FILE *file;
+    TraceFormat format;
+    vector<GenerationRecord> buffer;
+    atomic<uint64_t> head, tail; // pushed, written
+    atomic<uint64_t> dropped;
+    chrono::steady_clock::time_point startTime;
+    chrono::nanoseconds flushInterval;
+
+    thread writer;
+    atomic<bool> stopping;
+    mutex wakeMutex;
+    condition_variable wakeCondition;
+
+    void writerLoop();
+    void drain();
+    TraceWriter(const TraceWriter &);
+    TraceWriter &operator=(const TraceWriter &);
+};
+
+#endif
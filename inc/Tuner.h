@@ -0,0 +1,239 @@
+/**
+ * @file Tuner.h
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief Tuner Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef TUNER_H
+#define TUNER_H
+
+#include "GeneticAlgorithm.h"
+#include "Statistics.h"
+#include <string>
+#include <sstream>
+using namespace std;
+
+// The settings of one configuration of the genetic algorithm
+struct TunerConfiguration
+{
+    double mutationPercentage = 1.5;
+    double elitePercentage = 15.0;
+    Selection selection = Fast;
+    Crossover crossover = Uniform;
+    int populationSize = 100;
+    int kickOutAge = -1; // -1 to disable the kick out
+
+    string toString() const
+    {
+        const char *selections[] = {"Fast", "RouletteWheel", "MixSelection"};
+        const char *crossovers[] = {"Uniform", "OnePoint", "TwoPoint", "MixCrossover"};
+        ostringstream s;
+        s << "mutation " << mutationPercentage << "%, elite " << elitePercentage << "%, " << selections[selection] << ", "
+          << crossovers[crossover] << ", population " << populationSize << ", kick out age " << kickOutAge;
+        return s.str();
+    }
+};
+
+struct TunerResult
+{
+    TunerConfiguration configuration;
+    vector<double> fitness;  // the best fitness of each seed at the last checkpoint run
+    double mean;             // mean of %fitness%
+    double low, high;        // 95% confidence interval of the mean
+    double meanRank;         // mean rank over the seeds at the last race, 1 is the best
+    uint64_t generations;    // generations run by each seed
+    bool eliminated;         // eliminated by the race before the end
+};
+
+/**
+ * @brief Tune the settings of the genetic algorithm: run many configurations and seeds concurrently on a thread pool,
+ * compare them at every checkpoint and stop the configurations that are statistically worse than the best one (F-race).
+ * @note Each run uses the reproducible mode with the seeds 1..seedsCount, so every configuration sees the same seeds (the blocks of the race).
+ * The fitness function must be thread-safe.
+ */
+template <class T>
+class Tuner
+{
+public:
+    Tuner(function<double(T &)> fitnessFunction, bool maximizeFitness = true)
+    {
+        this->fitnessFunction = fitnessFunction;
+        this->maximizeFitness = maximizeFitness;
+        generationsCount = 0;
+    }
+
+    // Called on every new genetic algorithm before its population is initialized (fix function, termination conditions, ...)
+    void setSetupFunction(function<void(GeneticAlgorithm<T> &)> setupFunction) { this->setupFunction = setupFunction; }
+
+    void addConfiguration(const TunerConfiguration &configuration) { configurations.push_back(configuration); }
+    // Add every combination of the values
+    void addGrid(const vector<double> &mutationPercentages, const vector<double> &elitePercentages, const vector<Selection> &selections,
+                 const vector<Crossover> &crossovers, const vector<int> &populationSizes, const vector<int> &kickOutAges = vector<int>(1, -1));
+    vector<TunerConfiguration> &getConfigurations() { return configurations; }
+
+    // Set the number of threads (1 = serial), put 0 to use all hardware threads
+    void setThreadsCount(int threadsCount) { threadPool = make_shared<ThreadPool>(threadsCount); }
+    // Share a thread pool with other objects
+    void setThreadPool(shared_ptr<ThreadPool> threadPool) { this->threadPool = threadPool; }
+
+    /**
+     * @brief Race the configurations
+     *
+     * @param seedsCount number of runs per configuration, at least 2 to race
+     * @param generations number of generations of each run
+     * @param checkpointInterval number of generations between two races
+     * @param alpha significance level of the race
+     * @return the results of every configuration, the best first
+     */
+    vector<TunerResult> tune(int seedsCount, uint64_t generations, uint64_t checkpointInterval, double alpha = 0.05);
+
+    // Total generations run by the last tune(), over every configuration and seed
+    uint64_t getGenerationsCount() { return generationsCount; }
+
+private:
+    function<double(T &)> fitnessFunction;
+    bool maximizeFitness;
+    function<void(GeneticAlgorithm<T> &)> setupFunction;
+    vector<TunerConfiguration> configurations;
+    shared_ptr<ThreadPool> threadPool;
+    uint64_t generationsCount;
+};
+
+template <class T>
+void Tuner<T>::addGrid(const vector<double> &mutationPercentages, const vector<double> &elitePercentages, const vector<Selection> &selections,
+                       const vector<Crossover> &crossovers, const vector<int> &populationSizes, const vector<int> &kickOutAges)
+{
+    TunerConfiguration configuration;
+    for (double mutationPercentage : mutationPercentages)
+        for (double elitePercentage : elitePercentages)
+            for (Selection selection : selections)
+                for (Crossover crossover : crossovers)
+                    for (int populationSize : populationSizes)
+                        for (int kickOutAge : kickOutAges)
+                        {
+                            configuration.mutationPercentage = mutationPercentage;
+                            configuration.elitePercentage = elitePercentage;
+                            configuration.selection = selection;
+                            configuration.crossover = crossover;
+                            configuration.populationSize = populationSize;
+                            configuration.kickOutAge = kickOutAge;
+                            configurations.push_back(configuration);
+                        }
+}
+
+template <class T>
+vector<TunerResult> Tuner<T>::tune(int seedsCount, uint64_t generations, uint64_t checkpointInterval, double alpha)
+{
+    assert((!configurations.empty() && seedsCount > 0 && checkpointInterval > 0) && "Invalid tuner settings");
+    if (!threadPool)
+        threadPool = make_shared<ThreadPool>(0);
+
+    const int k = (int)configurations.size();
+    vector<unique_ptr<GeneticAlgorithm<T>>> runs(k * seedsCount); // run c * seedsCount + s
+    vector<double> best(runs.size());
+    vector<TunerResult> results(k);
+    vector<int> alive;
+    for (int c = 0; c < k; c++)
+    {
+        results[c].configuration = configurations[c];
+        results[c].meanRank = 1;
+        results[c].generations = 0;
+        results[c].eliminated = false;
+        alive.push_back(c);
+    }
+
+    threadPool->parallelFor(0, (int)runs.size(), [this, &runs, seedsCount, generations](int r)
+                            {
+                                TunerConfiguration &configuration = configurations[r / seedsCount];
+                                runs[r].reset(new GeneticAlgorithm<T>(fitnessFunction, maximizeFitness, generations, configuration.mutationPercentage,
+                                                                      configuration.elitePercentage, configuration.selection, configuration.crossover));
+                                GeneticAlgorithm<T> &ga = *runs[r];
+                                ga.setVerbose(false);
+                                ga.setSeed(r % seedsCount + 1);
+                                if (configuration.kickOutAge >= 0)
+                                    ga.setKickOutAge(configuration.kickOutAge);
+                                if (setupFunction != nullptr)
+                                    setupFunction(ga);
+                                ga.initializePopulation(configuration.populationSize); });
+
+    generationsCount = 0;
+    for (uint64_t done = 0; done < generations && !alive.empty();)
+    {
+        const uint64_t interval = min(checkpointInterval, generations - done);
+        vector<int> active;
+        for (int c : alive)
+            for (int s = 0; s < seedsCount; s++)
+                active.push_back(c * seedsCount + s);
+
+        threadPool->parallelFor(0, (int)active.size(), [&runs, &best, &active, interval](int i)
+                                {
+                                    best[active[i]] = runs[active[i]]->step(interval).getFitness(); });
+        done += interval;
+        generationsCount += interval * active.size();
+
+        for (int c : alive)
+        {
+            results[c].generations = done;
+            results[c].fitness.assign(best.begin() + c * seedsCount, best.begin() + (c + 1) * seedsCount);
+        }
+
+        // Race the surviving configurations, the seeds are the blocks.
+        vector<vector<double>> measures(seedsCount, vector<double>(alive.size()));
+        for (int s = 0; s < seedsCount; s++)
+            for (size_t j = 0; j < alive.size(); j++)
+            {
+                double fitness = best[alive[j] * seedsCount + s];
+                measures[s][j] = maximizeFitness ? -fitness : fitness;
+            }
+        vector<bool> eliminated;
+        vector<double> meanRanks;
+        friedmanRace(measures, alpha, eliminated, meanRanks);
+
+        vector<int> survivors;
+        for (size_t j = 0; j < alive.size(); j++)
+        {
+            int c = alive[j];
+            results[c].meanRank = meanRanks[j];
+            if (eliminated[j] && done < generations)
+            {
+                results[c].eliminated = true;
+                for (int s = 0; s < seedsCount; s++)
+                    runs[c * seedsCount + s].reset(); // free the population
+            }
+            else
+                survivors.push_back(c);
+        }
+        alive.swap(survivors);
+    }
+
+    for (auto &result : results)
+    {
+        const int n = (int)result.fitness.size();
+        double sum = 0, squares = 0;
+        for (double fitness : result.fitness)
+            sum += fitness;
+        result.mean = n ? sum / n : 0;
+        for (double fitness : result.fitness)
+            squares += (fitness - result.mean) * (fitness - result.mean);
+        double margin = (n > 1) ? studentQuantile(0.975, n - 1) * sqrt(squares / (n - 1) / n) : 0;
+        result.low = result.mean - margin;
+        result.high = result.mean + margin;
+    }
+
+    // The survivors first, then the configurations that went further, then the best mean.
+    bool maximize = maximizeFitness;
+    stable_sort(results.begin(), results.end(), [maximize](const TunerResult &a, const TunerResult &b)
+                {
+                    if (a.eliminated != b.eliminated)
+                        return !a.eliminated;
+                    if (a.generations != b.generations)
+                        return a.generations > b.generations;
+                    return maximize ? a.mean > b.mean : a.mean < b.mean; });
+    return results;
+}
+
+#endif
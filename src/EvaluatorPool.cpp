@@ -0,0 +1,485 @@
+/**
+ * @file EvaluatorPool.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief EvaluatorPool Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "EvaluatorPool.h"
+#include <thread>
+#include <chrono>
+#include <deque>
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+#if EVALUATOR_POOL_PROCESSES
+#include <unistd.h>
+#include <signal.h>
+#include <poll.h>
+#include <errno.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+
+// A write to a dead worker fails with EPIPE instead of raising SIGPIPE, the signal handling of the host process is left alone.
+#ifdef MSG_NOSIGNAL
+static const int sendFlags = MSG_NOSIGNAL;
+#else
+static const int sendFlags = 0; // SO_NOSIGPIPE on the sockets instead (macOS)
+#endif
+
+static int socketPair(int channel[2])
+{
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, channel) != 0)
+        return -1;
+#ifdef SO_NOSIGPIPE
+    int on = 1;
+    setsockopt(channel[0], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+    setsockopt(channel[1], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+    return 0;
+}
+#endif
+
+EvaluatorPool::EvaluatorPool(int processesCount, int chromosomeSize, function<double(uint8_t *)> fitnessFunction, double timeout_ms, double penaltyFitness, int batchSize)
+{
+    if (processesCount <= 0)
+        processesCount = max(1, (int)thread::hardware_concurrency());
+    this->processesCount = processesCount;
+    this->chromosomeSize = chromosomeSize;
+    this->fitnessFunction = fitnessFunction;
+    this->timeout_ms = timeout_ms;
+    this->penaltyFitness = penaltyFitness;
+    this->batchSize = max(1, batchSize);
+    timeoutsCount = 0;
+    crashesCount = 0;
+    inProcessCount = 0;
+    lostCount = 0;
+
+#if EVALUATOR_POOL_PROCESSES
+    workers.resize(processesCount);
+    for (auto &worker : workers)
+    {
+        worker.pid = -1;
+        worker.channel = -1;
+    }
+
+    // The only fork of the calling process, the zygote forks the workers.
+    zygote = -1;
+    zygotePid = -1;
+    vector<pid_t> children;
+    children.reserve(processesCount);
+    int control[2];
+    if (socketPair(control) == 0)
+    {
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            close(control[0]);
+            zygoteLoop(control[1], children);
+        }
+        close(control[1]);
+        if (pid > 0)
+        {
+            zygote = control[0];
+            zygotePid = pid;
+        }
+        else
+            close(control[0]);
+    }
+
+    for (auto &worker : workers)
+        spawn(worker);
+#endif
+}
+
+EvaluatorPool::~EvaluatorPool()
+{
+#if EVALUATOR_POOL_PROCESSES
+    for (auto &worker : workers)
+        kill(worker);
+    // At the end of its requests, the zygote kills the workers left and exits.
+    if (zygote >= 0)
+        close(zygote);
+    if (zygotePid > 0)
+        waitpid(zygotePid, nullptr, 0);
+#endif
+}
+
+#if EVALUATOR_POOL_PROCESSES
+
+static double now_ms()
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool readAll(int fd, void *data, size_t size)
+{
+    uint8_t *p = (uint8_t *)data;
+    while (size > 0)
+    {
+        ssize_t r = read(fd, p, size);
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r <= 0)
+            return false;
+        p += r;
+        size -= r;
+    }
+    return true;
+}
+
+static bool writeAll(int fd, const void *data, size_t size)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    while (size > 0)
+    {
+        ssize_t w = send(fd, p, size, sendFlags);
+        if (w < 0 && errno == EINTR)
+            continue;
+        if (w <= 0)
+            return false;
+        p += w;
+        size -= w;
+    }
+    return true;
+}
+
+// The requests to the zygote: int32 ZygoteSpawn, 0 -> int32 pid with the socket of the worker (pid -1 and no socket on failure),
+// int32 ZygoteKill, pid -> no answer
+enum
+{
+    ZygoteSpawn,
+    ZygoteKill
+};
+
+static bool sendDescriptor(int socket, int32_t value, int fd)
+{
+    struct iovec data;
+    data.iov_base = &value;
+    data.iov_len = sizeof(value);
+    union
+    {
+        char buffer[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr align;
+    } control;
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    memset(&control, 0, sizeof(control));
+    message.msg_iov = &data;
+    message.msg_iovlen = 1;
+    if (fd >= 0)
+    {
+        message.msg_control = control.buffer;
+        message.msg_controllen = sizeof(control.buffer);
+        struct cmsghdr *header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(header), &fd, sizeof(int));
+    }
+    ssize_t w;
+    do
+        w = sendmsg(socket, &message, sendFlags);
+    while (w < 0 && errno == EINTR);
+    return w == (ssize_t)sizeof(value);
+}
+
+static bool receiveDescriptor(int socket, int32_t &value, int &fd)
+{
+    fd = -1;
+    struct iovec data;
+    data.iov_base = &value;
+    data.iov_len = sizeof(value);
+    union
+    {
+        char buffer[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr align;
+    } control;
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &data;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+    ssize_t r;
+    do
+        r = recvmsg(socket, &message, 0);
+    while (r < 0 && errno == EINTR);
+    struct cmsghdr *header = r > 0 ? CMSG_FIRSTHDR(&message) : nullptr;
+    if (header != nullptr && header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS)
+        memcpy(&fd, CMSG_DATA(header), sizeof(int));
+    return r == (ssize_t)sizeof(value);
+}
+
+void EvaluatorPool::zygoteLoop(int control, vector<pid_t> &children)
+{
+    // Single thread, async-signal-safe calls only, and no allocation: %children% never grows past its capacity.
+    int32_t request[2];
+    while (readAll(control, request, sizeof(request)))
+    {
+        if (request[0] == ZygoteKill)
+        {
+            // Only its own children, which are not reaped before this, so the pid is not reused.
+            vector<pid_t>::iterator child = find(children.begin(), children.end(), (pid_t)request[1]);
+            if (child == children.end())
+                continue;
+            ::kill(*child, SIGKILL);
+            waitpid(*child, nullptr, 0);
+            children.erase(child);
+            continue;
+        }
+
+        int channel[2];
+        pid_t pid = -1;
+        if (children.size() < children.capacity() && socketPair(channel) == 0)
+        {
+            pid = fork();
+            if (pid == 0)
+            {
+                close(control);
+                close(channel[0]);
+                workerLoop(channel[1]);
+            }
+            close(channel[1]);
+            if (pid > 0)
+                children.push_back(pid);
+            bool sent = sendDescriptor(control, (int32_t)pid, pid > 0 ? channel[0] : -1);
+            close(channel[0]);
+            if (!sent)
+                break;
+        }
+        else if (!sendDescriptor(control, -1, -1))
+            break;
+    }
+
+    // The pool is destroyed, or its process is gone.
+    for (pid_t child : children)
+    {
+        ::kill(child, SIGKILL);
+        waitpid(child, nullptr, 0);
+    }
+    _exit(0);
+}
+
+void EvaluatorPool::spawn(Worker &worker)
+{
+    worker.count = worker.received = 0;
+    worker.partial.clear();
+    if (zygote < 0)
+        return;
+
+    int32_t request[2] = {ZygoteSpawn, 0};
+    int32_t pid;
+    int channel = -1;
+    if (!writeAll(zygote, request, sizeof(request)) || !receiveDescriptor(zygote, pid, channel))
+    {
+        // The zygote is gone, no more workers.
+        if (channel >= 0)
+            close(channel);
+        close(zygote);
+        zygote = -1;
+        return;
+    }
+    if (pid <= 0 || channel < 0)
+    {
+        if (channel >= 0)
+            close(channel);
+        return;
+    }
+    worker.pid = pid;
+    worker.channel = channel;
+}
+
+void EvaluatorPool::kill(Worker &worker)
+{
+    if (worker.pid <= 0)
+        return;
+    close(worker.channel);
+    int32_t request[2] = {ZygoteKill, (int32_t)worker.pid};
+    if (zygote >= 0 && !writeAll(zygote, request, sizeof(request)))
+    {
+        close(zygote);
+        zygote = -1;
+    }
+    worker.pid = -1;
+    worker.channel = -1;
+    worker.count = worker.received = 0;
+}
+
+bool EvaluatorPool::send(Worker &worker, uint8_t *chromosomes, int first, int count)
+{
+    // message: int32 count, then count chromosomes
+    vector<uint8_t> message(sizeof(int32_t) + (size_t)count * chromosomeSize);
+    int32_t n = count;
+    memcpy(message.data(), &n, sizeof(n));
+    memcpy(message.data() + sizeof(n), chromosomes + (size_t)first * chromosomeSize, (size_t)count * chromosomeSize);
+    if (!writeAll(worker.channel, message.data(), message.size()))
+        return false;
+
+    worker.first = first;
+    worker.count = count;
+    worker.received = 0;
+    worker.partial.clear();
+    worker.deadline = now_ms() + timeout_ms;
+    return true;
+}
+
+void EvaluatorPool::workerLoop(int channel)
+{
+    vector<uint8_t> batch;
+    for (;;)
+    {
+        int32_t count;
+        if (!readAll(channel, &count, sizeof(count)))
+            _exit(0);
+        batch.resize((size_t)count * chromosomeSize);
+        if (!readAll(channel, batch.data(), batch.size()))
+            _exit(0);
+
+        // Every fitness is sent on its own, so a timeout or a crash points to one chromosome.
+        for (int i = 0; i < count; i++)
+        {
+            double fitness = fitnessFunction(batch.data() + (size_t)i * chromosomeSize);
+            if (!writeAll(channel, &fitness, sizeof(fitness)))
+                _exit(0);
+        }
+    }
+}
+
+bool EvaluatorPool::evaluate(uint8_t *chromosomes, int count, double *fitness)
+{
+    fill(fitness, fitness + count, (double)NAN); // until a worker sends it
+    deque<pair<int, int>> pending; // [first, count) ranges not sent yet
+    if (count > 0)
+        pending.push_back(make_pair(0, count));
+    int unsent = count, finished = 0;
+
+    // The chromosome at the head of the batch gets the penalty, the rest of the batch is sent again.
+    auto fail = [&](Worker &worker)
+    {
+        fitness[worker.first + worker.received] = penaltyFitness;
+        ++finished;
+        int rest = worker.count - worker.received - 1;
+        if (rest > 0)
+        {
+            pending.push_front(make_pair(worker.first + worker.received + 1, rest));
+            unsent += rest;
+        }
+        kill(worker);
+        spawn(worker);
+    };
+
+    while (finished < count)
+    {
+        // Give a batch to every idle worker.
+        for (auto &worker : workers)
+        {
+            if (worker.pid <= 0)
+                spawn(worker);
+            if (worker.pid <= 0 || worker.count > 0 || pending.empty())
+                continue;
+
+            int share = (unsent + processesCount - 1) / processesCount;
+            int n = min(pending.front().second, min(batchSize, share));
+            if (!send(worker, chromosomes, pending.front().first, n))
+            {
+                kill(worker); // died while idle, nothing to blame
+                continue;
+            }
+            pending.front().first += n;
+            pending.front().second -= n;
+            if (pending.front().second == 0)
+                pending.pop_front();
+            unsent -= n;
+        }
+
+        vector<pollfd> fds;
+        vector<Worker *> busy;
+        double now = now_ms(), wait = -1;
+        for (auto &worker : workers)
+            if (worker.pid > 0 && worker.count > 0)
+            {
+                pollfd fd;
+                fd.fd = worker.channel;
+                fd.events = POLLIN;
+                fd.revents = 0;
+                fds.push_back(fd);
+                busy.push_back(&worker);
+                if (timeout_ms > 0)
+                    wait = (wait < 0) ? max(0.0, worker.deadline - now) : min(wait, max(0.0, worker.deadline - now));
+            }
+
+        if (busy.empty())
+        {
+            // No worker process can be started, evaluate in this process and report it.
+            for (auto &range : pending)
+                for (int i = range.first; i < range.first + range.second; i++)
+                    fitness[i] = fitnessFunction(chromosomes + (size_t)i * chromosomeSize);
+            inProcessCount += unsent;
+            return false;
+        }
+
+        if (poll(fds.data(), fds.size(), wait < 0 ? -1 : (int)ceil(wait)) < 0 && errno != EINTR)
+        {
+            // The results in flight can not be read any more: the unfinished chromosomes keep a NaN fitness.
+            for (Worker *worker : busy)
+                kill(*worker);
+            lostCount += count - finished;
+            return false;
+        }
+
+        now = now_ms();
+        for (size_t k = 0; k < busy.size(); k++)
+        {
+            Worker &worker = *busy[k];
+            if (fds[k].revents & (POLLIN | POLLHUP | POLLERR))
+            {
+                uint8_t buffer[512];
+                ssize_t r = read(worker.channel, buffer, sizeof(buffer));
+                if (r > 0)
+                {
+                    worker.partial.insert(worker.partial.end(), buffer, buffer + r);
+                    size_t used = 0;
+                    for (; worker.partial.size() - used >= sizeof(double); used += sizeof(double))
+                    {
+                        memcpy(&fitness[worker.first + worker.received], worker.partial.data() + used, sizeof(double));
+                        ++worker.received;
+                        ++finished;
+                        worker.deadline = now + timeout_ms;
+                    }
+                    worker.partial.erase(worker.partial.begin(), worker.partial.begin() + used);
+                    if (worker.received == worker.count)
+                        worker.count = 0;
+                    continue;
+                }
+                if (r == 0 || (errno != EINTR && errno != EAGAIN))
+                {
+                    ++crashesCount;
+                    fail(worker);
+                    continue;
+                }
+            }
+            if (timeout_ms > 0 && now >= worker.deadline)
+            {
+                ++timeoutsCount;
+                fail(worker);
+            }
+        }
+    }
+    return true;
+}
+
+#else
+
+bool EvaluatorPool::evaluate(uint8_t *chromosomes, int count, double *fitness)
+{
+    // Evaluated in this process by design, see the class note.
+    for (int i = 0; i < count; i++)
+        fitness[i] = fitnessFunction(chromosomes + (size_t)i * chromosomeSize);
+    return true;
+}
+
+#endif
@@ -0,0 +1,37 @@
+/**
+ * @file GeneLayout.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief GeneLayout Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneLayout.h"
+
+GeneLayout &GeneLayout::add(size_t offset, size_t size)
+{
+    offsets.push_back((int)offset);
+    sizes.push_back((int)size);
+    return *this;
+}
+
+GeneLayout &GeneLayout::addArray(size_t offset, size_t size, int count)
+{
+    for (int i = 0; i < count; i++)
+        add(offset + i * size, size);
+    return *this;
+}
+
+bool GeneLayout::isValid(int chromosomeSize) const
+{
+    int end = 0;
+    for (size_t i = 0; i < offsets.size(); i++)
+    {
+        if (sizes[i] <= 0 || offsets[i] < end)
+            return false;
+        end = offsets[i] + sizes[i];
+    }
+    return end <= chromosomeSize;
+}
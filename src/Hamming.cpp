@@ -0,0 +1,191 @@
+/**
+ * @file Hamming.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief HammingIndex Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "Hamming.h"
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+
+HammingIndex::HammingIndex(int chromosomeSize, int tablesCount, int sampledBits)
+{
+    reset(chromosomeSize, tablesCount, sampledBits);
+}
+
+void HammingIndex::reset(int chromosomeSize, int tablesCount, int sampledBits)
+{
+    this->chromosomeSize = chromosomeSize;
+    this->tablesCount = tablesCount;
+    words = (chromosomeSize + 7) / 8;
+
+    int bits = chromosomeSize * 8;
+    if (sampledBits <= 0)
+        sampledBits = max(1, min(24, bits / 4));
+    this->sampledBits = min(sampledBits, max(bits, 1));
+
+    // Fixed positions, so a seeded run does not depend on rand().
+    minstd_rand random(1 + tablesCount);
+    sampledPositions.assign(tablesCount, vector<int>());
+    for (int t = 0; t < tablesCount; t++)
+        for (int i = 0; i < this->sampledBits; i++)
+            sampledPositions[t].push_back(random() % max(bits, 1));
+
+    query.assign(words, 0);
+    queryKeys.assign(tablesCount, 0);
+    clear();
+}
+
+void HammingIndex::clear()
+{
+    count = 0;
+    visitStamp = 0;
+    linearScansCount = 0;
+    chromosomes.clear();
+    visited.clear();
+    buckets.assign(tablesCount, unordered_map<uint64_t, vector<int>>());
+}
+
+void HammingIndex::pack(const uint8_t *chromosome, uint64_t *packed)
+{
+    packed[words - 1] = 0;
+    memcpy(packed, chromosome, chromosomeSize);
+}
+
+uint64_t HammingIndex::key(int table, const uint64_t *packed)
+{
+    uint64_t k = 0;
+    for (int position : sampledPositions[table])
+        k = (k << 1) | ((packed[position >> 6] >> (position & 63)) & 1);
+    return k;
+}
+
+void HammingIndex::addToBuckets(int id)
+{
+    const uint64_t *packed = &chromosomes[(size_t)id * words];
+    for (int t = 0; t < tablesCount; t++)
+        buckets[t][key(t, packed)].push_back(id);
+}
+
+void HammingIndex::removeFromBuckets(int id)
+{
+    const uint64_t *packed = &chromosomes[(size_t)id * words];
+    for (int t = 0; t < tablesCount; t++)
+    {
+        vector<int> &bucket = buckets[t][key(t, packed)];
+        for (size_t i = 0; i < bucket.size(); i++)
+            if (bucket[i] == id)
+            {
+                bucket[i] = bucket.back();
+                bucket.pop_back();
+                break;
+            }
+    }
+}
+
+int HammingIndex::insert(const uint8_t *chromosome)
+{
+    chromosomes.resize(chromosomes.size() + words);
+    pack(chromosome, &chromosomes[(size_t)count * words]);
+    visited.push_back(0);
+    addToBuckets(count);
+    return count++;
+}
+
+void HammingIndex::replace(int id, const uint8_t *chromosome)
+{
+    removeFromBuckets(id);
+    pack(chromosome, &chromosomes[(size_t)id * words]);
+    addToBuckets(id);
+}
+
+void HammingIndex::bucketNeighbours(const uint8_t *chromosome, int radius, vector<pair<int, int>> &neighbours)
+{
+    pack(chromosome, query.data());
+    if (++visitStamp == 0)
+    {
+        fill(visited.begin(), visited.end(), 0);
+        visitStamp = 1;
+    }
+
+    for (int t = 0; t < tablesCount; t++)
+    {
+        queryKeys[t] = key(t, query.data());
+        probe(t, queryKeys[t], radius, neighbours);
+    }
+}
+
+void HammingIndex::probe(int table, uint64_t key, int radius, vector<pair<int, int>> &neighbours)
+{
+    unordered_map<uint64_t, vector<int>>::iterator bucket = buckets[table].find(key);
+    if (bucket == buckets[table].end())
+        return;
+    for (int id : bucket->second)
+        if (visited[id] != visitStamp)
+        {
+            visited[id] = visitStamp;
+            int distance = hammingDistance(query.data(), &chromosomes[(size_t)id * words], words);
+            if (distance <= radius)
+                neighbours.push_back(make_pair(distance, id));
+        }
+}
+
+void HammingIndex::nearest(const uint8_t *chromosome, int k, vector<pair<int, int>> &neighbours)
+{
+    neighbours.clear();
+    if (count == 0 || k <= 0)
+        return;
+
+    const int radius = chromosomeSize * 8;
+    bucketNeighbours(chromosome, radius, neighbours);
+
+    // Multi-probe: the buckets whose key differs in one sampled bit, then in two, hold the next closest chromosomes.
+    // A probe is one hash lookup, about the cost of one distance, so stop when the probes would cost more than the scan.
+    const int keyBits = min(sampledBits, 64);
+    int64_t probes = 0;
+    for (int flips = 1; flips <= 2 && (int)neighbours.size() < k; flips++)
+    {
+        int64_t cost = (int64_t)tablesCount * (flips == 1 ? keyBits : keyBits * (keyBits - 1) / 2);
+        if (probes + cost > count)
+            break;
+        probes += cost;
+        for (int t = 0; t < tablesCount; t++)
+            for (int i = 0; i < keyBits; i++)
+            {
+                uint64_t flipped = queryKeys[t] ^ (1ULL << i);
+                if (flips == 1)
+                    probe(t, flipped, radius, neighbours);
+                else
+                    for (int j = 0; j < i; j++)
+                        probe(t, flipped ^ (1ULL << j), radius, neighbours);
+            }
+    }
+
+    // Still not enough candidates, scan the whole index.
+    if ((int)neighbours.size() < k)
+    {
+        ++linearScansCount;
+        neighbours.clear();
+        for (int id = 0; id < count; id++)
+            neighbours.push_back(make_pair(hammingDistance(query.data(), &chromosomes[(size_t)id * words], words), id));
+    }
+
+    k = min(k, (int)neighbours.size());
+    partial_sort(neighbours.begin(), neighbours.begin() + k, neighbours.end());
+    neighbours.resize(k);
+}
+
+void HammingIndex::within(const uint8_t *chromosome, int radius, vector<pair<int, int>> &neighbours)
+{
+    neighbours.clear();
+    if (count == 0 || radius < 0)
+        return;
+    bucketNeighbours(chromosome, radius, neighbours);
+    sort(neighbours.begin(), neighbours.end());
+}
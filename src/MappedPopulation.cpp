@@ -0,0 +1,109 @@
+/**
+ * @file MappedPopulation.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief MappedPopulation Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "MappedPopulation.h"
+#include <stdlib.h>
+#if MAPPED_POPULATION_FILES
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+MappedPopulation::MappedPopulation()
+{
+    data = nullptr;
+    count = 0;
+    chromosomeSize = 0;
+    current = 0;
+    length = 0;
+    fd = -1;
+}
+
+MappedPopulation::~MappedPopulation()
+{
+    close();
+}
+
+bool MappedPopulation::open(const string &path, int64_t count, int chromosomeSize)
+{
+    close();
+    this->count = count;
+    this->chromosomeSize = chromosomeSize;
+    current = 0;
+    length = (size_t)(2 * count * chromosomeSize);
+    if (length == 0)
+        return false;
+
+#if MAPPED_POPULATION_FILES
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return false;
+    if (ftruncate(fd, (off_t)length) != 0)
+    {
+        close();
+        return false;
+    }
+    void *p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+    {
+        close();
+        return false;
+    }
+    data = (uint8_t *)p;
+#else
+    (void)path;
+    data = (uint8_t *)malloc(length);
+#endif
+    return data != nullptr;
+}
+
+void MappedPopulation::close()
+{
+#if MAPPED_POPULATION_FILES
+    if (data != nullptr)
+        munmap(data, length);
+    if (fd >= 0)
+        ::close(fd);
+#else
+    free(data);
+#endif
+    data = nullptr;
+    fd = -1;
+}
+
+void MappedPopulation::advise(int64_t first, int64_t count, bool next, int advice)
+{
+#if MAPPED_POPULATION_FILES
+    if (data == nullptr || count <= 0)
+        return;
+    // madvise works on whole pages: round the range out to the pages it touches.
+    const uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t begin = (uintptr_t)chromosome(first, next) & ~(page - 1);
+    uintptr_t end = ((uintptr_t)chromosome(first + count, next) + page - 1) & ~(page - 1);
+    madvise((void *)begin, end - begin, advice);
+#else
+    (void)first;
+    (void)count;
+    (void)next;
+    (void)advice;
+#endif
+}
+
+#if MAPPED_POPULATION_FILES
+void MappedPopulation::adviseSequential(int64_t first, int64_t count, bool next) { advise(first, count, next, MADV_SEQUENTIAL); }
+void MappedPopulation::adviseRandom(int64_t first, int64_t count, bool next) { advise(first, count, next, MADV_RANDOM); }
+void MappedPopulation::adviseWillNeed(int64_t first, int64_t count, bool next) { advise(first, count, next, MADV_WILLNEED); }
+void MappedPopulation::adviseDontNeed(int64_t first, int64_t count, bool next) { advise(first, count, next, MADV_DONTNEED); }
+#else
+void MappedPopulation::adviseSequential(int64_t first, int64_t count, bool next) { advise(first, count, next, 0); }
+void MappedPopulation::adviseRandom(int64_t first, int64_t count, bool next) { advise(first, count, next, 0); }
+void MappedPopulation::adviseWillNeed(int64_t first, int64_t count, bool next) { advise(first, count, next, 0); }
+void MappedPopulation::adviseDontNeed(int64_t first, int64_t count, bool next) { advise(first, count, next, 0); }
+#endif
@@ -0,0 +1,150 @@
+/**
+ * @file MultiObjective.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief Non-dominated sorting and crowding distance are a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "MultiObjective.h"
+#include <algorithm>
+#include <map>
+#include <math.h>
+
+// Is p dominated by q, knowing that q comes before p in lexicographic order and they are not equal
+static bool dominatedBy(const vector<double> &p, const vector<double> &q)
+{
+    for (size_t m = 1; m < p.size(); m++)
+        if (q[m] > p[m])
+            return false;
+    return true;
+}
+
+int nonDominatedSort(const vector<vector<double>> &objectives, vector<int> &rank)
+{
+    const int n = (int)objectives.size();
+    rank.assign(n, 0);
+    if (n == 0)
+        return 0;
+    const int m = (int)objectives[0].size();
+
+    // Sort lexicographically, a point can only be dominated by points before it.
+    vector<int> order(n);
+    for (int i = 0; i < n; i++)
+        order[i] = i;
+    sort(order.begin(), order.end(), [&objectives](int a, int b) -> bool
+         { return objectives[a] < objectives[b]; });
+
+    // Front k dominates p => every front before k dominates p, so the front of p is found by binary search.
+    // 2 objectives: a front is dominated by its last member (the lowest second objective).
+    vector<double> lastSecond;
+    // 3 objectives: a front keeps its (second, third) staircase, third objective decreasing.
+    vector<map<double, double>> staircases;
+    // More objectives: a front keeps all its members.
+    vector<vector<int>> members;
+
+    int frontsCount = 0;
+    for (int i = 0; i < n; i++)
+    {
+        const int p = order[i];
+        const vector<double> &point = objectives[p];
+
+        if (i > 0 && objectives[order[i - 1]] == point) // duplicate point, same front
+        {
+            rank[p] = rank[order[i - 1]];
+            continue;
+        }
+
+        auto dominates = [&](int front) -> bool
+        {
+            if (m == 1)
+                return true; // every point before has a lower objective
+            if (m == 2)
+                return lastSecond[front] <= point[1];
+            if (m == 3)
+            {
+                map<double, double>::iterator it = staircases[front].upper_bound(point[1]);
+                if (it == staircases[front].begin())
+                    return false;
+                --it;
+                return it->second <= point[2];
+            }
+            for (int q : members[front])
+                if (dominatedBy(point, objectives[q]))
+                    return true;
+            return false;
+        };
+
+        int low = 0, high = frontsCount; // first front that does not dominate p
+        while (low < high)
+        {
+            int mid = (low + high) / 2;
+            if (dominates(mid))
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        if (low == frontsCount)
+        {
+            ++frontsCount;
+            if (m == 2)
+                lastSecond.push_back(point[1]);
+            else if (m == 3)
+                staircases.push_back(map<double, double>());
+            else if (m > 3)
+                members.push_back(vector<int>());
+        }
+
+        rank[p] = low;
+        if (m == 2)
+            lastSecond[low] = point[1];
+        else if (m == 3)
+        {
+            map<double, double> &staircase = staircases[low];
+            map<double, double>::iterator it = staircase.lower_bound(point[1]);
+            while (it != staircase.end() && it->second >= point[2])
+                it = staircase.erase(it);
+            staircase[point[1]] = point[2];
+        }
+        else if (m > 3)
+            members[low].push_back(p);
+    }
+
+    return frontsCount;
+}
+
+void crowdingDistance(const vector<vector<double>> &objectives, const vector<int> &members, vector<double> &distance)
+{
+    if (distance.size() < objectives.size())
+        distance.resize(objectives.size());
+    for (int p : members)
+        distance[p] = 0;
+
+    const int k = (int)members.size();
+    if (k == 0)
+        return;
+    if (k <= 2)
+    {
+        for (int p : members)
+            distance[p] = HUGE_VAL;
+        return;
+    }
+
+    vector<int> sorted = members;
+    const int m = (int)objectives[members[0]].size();
+    for (int o = 0; o < m; o++)
+    {
+        sort(sorted.begin(), sorted.end(), [&objectives, o](int a, int b) -> bool
+             { return objectives[a][o] < objectives[b][o]; });
+
+        double range = objectives[sorted[k - 1]][o] - objectives[sorted[0]][o];
+        distance[sorted[0]] = distance[sorted[k - 1]] = HUGE_VAL;
+        if (range == 0)
+            continue;
+        for (int i = 1; i < k - 1; i++)
+            distance[sorted[i]] += (objectives[sorted[i + 1]][o] - objectives[sorted[i - 1]][o]) / range;
+    }
+}
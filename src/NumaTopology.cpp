@@ -0,0 +1,126 @@
+/**
+ * @file NumaTopology.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief NumaTopology Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "NumaTopology.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// The CPUs the process may run on
+static vector<int> usableCpus()
+{
+    vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            if (CPU_ISSET(cpu, &set))
+                cpus.push_back(cpu);
+#endif
+    if (cpus.empty())
+        for (int cpu = 0; cpu < max(1, (int)thread::hardware_concurrency()); cpu++)
+            cpus.push_back(cpu);
+    return cpus;
+}
+
+NumaTopology::NumaTopology()
+{
+    vector<int> usable = usableCpus();
+#ifdef __linux__
+    for (int node = 0;; node++)
+    {
+        char path[64];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE *file = fopen(path, "r");
+        if (file == nullptr)
+            break;
+        char line[4096] = "";
+        if (fgets(line, sizeof(line), file) == nullptr)
+            line[0] = 0;
+        fclose(file);
+
+        vector<int> cpus;
+        for (int cpu : parseCpuList(line))
+            if (binary_search(usable.begin(), usable.end(), cpu))
+                cpus.push_back(cpu);
+        if (!cpus.empty())
+            nodes.push_back(cpus);
+    }
+#endif
+    if (nodes.empty())
+        nodes.push_back(usable);
+}
+
+int NumaTopology::getNode(int cpu) const
+{
+    for (size_t node = 0; node < nodes.size(); node++)
+        if (find(nodes[node].begin(), nodes[node].end(), cpu) != nodes[node].end())
+            return (int)node;
+    return -1;
+}
+
+vector<int> NumaTopology::place(int threadsCount) const
+{
+    vector<int> cpus(threadsCount);
+    vector<int> used(nodes.size(), 0);
+    for (int t = 0; t < threadsCount; t++)
+    {
+        int node = (int)((int64_t)t * nodes.size() / threadsCount);
+        cpus[t] = nodes[node][used[node]++ % nodes[node].size()];
+    }
+    return cpus;
+}
+
+bool NumaTopology::pin(thread &worker, int cpu)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(worker.native_handle(), sizeof(set), &set) == 0;
+#else
+    (void)worker;
+    (void)cpu;
+    return false;
+#endif
+}
+
+vector<int> NumaTopology::parseCpuList(const string &list)
+{
+    vector<int> cpus;
+    const char *p = list.c_str();
+    while (*p)
+    {
+        char *end;
+        long first = strtol(p, &end, 10);
+        if (end == p)
+        {
+            ++p; // a separator or the new line
+            continue;
+        }
+        long last = first;
+        p = end;
+        if (*p == '-')
+        {
+            last = strtol(p + 1, &end, 10);
+            p = end;
+        }
+        for (long cpu = first; cpu <= last; cpu++)
+            cpus.push_back((int)cpu);
+    }
+    sort(cpus.begin(), cpus.end());
+    cpus.erase(unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
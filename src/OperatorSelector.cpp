@@ -0,0 +1,118 @@
+/**
+ * @file OperatorSelector.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief OperatorSelector Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "OperatorSelector.h"
+#include <math.h>
+
+void OperatorSelector::reset(const vector<double> &initialProbabilities, Adaptation adaptation, double minProbability, double adaptationRate)
+{
+    this->adaptation = adaptation;
+    this->minProbability = minProbability;
+    this->adaptationRate = adaptationRate;
+    maxImprovement = 0;
+    totalUses = 0;
+
+    double sum = 0;
+    for (double p : initialProbabilities)
+        sum += p;
+
+    stats.assign(initialProbabilities.size(), OperatorStats());
+    for (size_t i = 0; i < stats.size(); i++)
+    {
+        stats[i].probability = initialProbabilities[i] / sum;
+        if (adaptation == ProbabilityMatching)
+            stats[i].quality = stats[i].probability; // no reward yet, start from the fixed mix
+    }
+}
+
+int OperatorSelector::select(double random)
+{
+    const int k = (int)stats.size();
+
+    int selected = k - 1;
+    if (adaptation == MultiArmedBandit)
+    {
+        // UCB1, try every operator once first. The pending selections count as uses, so the bound of an operator
+        // shrinks as soon as it is selected, before its offspring are credited.
+        double bestBound = -HUGE_VAL;
+        for (int i = 0; i < k; i++)
+        {
+            if (stats[i].uses == 0)
+            {
+                selected = i;
+                break;
+            }
+            double bound = stats[i].quality + sqrt(2.0 * log((double)totalUses) / stats[i].uses);
+            if (bound > bestBound)
+            {
+                bestBound = bound;
+                selected = i;
+            }
+        }
+    }
+    else
+        for (int i = 0; i < k; i++)
+        {
+            random -= stats[i].probability;
+            if (random < 0)
+            {
+                selected = i;
+                break;
+            }
+        }
+
+    ++stats[selected].uses;
+    ++totalUses;
+    if (adaptation == MultiArmedBandit)
+        updateProbabilities();
+    return selected;
+}
+
+void OperatorSelector::credit(int index, double improvement)
+{
+    OperatorStats &s = stats[index];
+    ++s.credits;
+
+    double reward = 0;
+    if (improvement > 0 && !isinf(improvement))
+    {
+        ++s.improvements;
+        if (improvement > maxImprovement)
+            maxImprovement = improvement;
+        reward = improvement / maxImprovement;
+    }
+
+    s.reward += reward;
+    if (adaptation == MultiArmedBandit)
+        s.quality = s.reward / s.credits;
+    else
+    {
+        s.quality += adaptationRate * (reward - s.quality);
+        updateProbabilities();
+    }
+}
+
+void OperatorSelector::updateProbabilities()
+{
+    const int k = (int)stats.size();
+    if (adaptation == MultiArmedBandit) // the share of the selections
+    {
+        for (auto &s : stats)
+            s.probability = (double)s.uses / totalUses;
+        return;
+    }
+
+    double sum = 0;
+    for (auto &s : stats)
+        sum += s.quality;
+
+    for (auto &s : stats)
+        s.probability = (sum > 0) ? minProbability + (1 - k * minProbability) * s.quality / sum : 1.0 / k;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file PopulationStatistics.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief PopulationStatistics Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "PopulationStatistics.h"
+#include <math.h>
+
+void PopulationStatistics::reset(int chromosomeSize)
+{
+    this->chromosomeSize = chromosomeSize;
+    count = fitnessCount = 0;
+    mean = m2 = 0;
+    ones.assign(chromosomeSize * 8, 0);
+}
+
+void PopulationStatistics::add(const uint8_t *chromosome, double fitness)
+{
+    ++count;
+    for (int i = 0; i < chromosomeSize * 8; i++)
+        ones[i] += (chromosome[i >> 3] >> (i & 7)) & 1;
+
+    if (!isfinite(fitness))
+        return;
+    ++fitnessCount;
+    double delta = fitness - mean;
+    mean += delta / fitnessCount;
+    m2 += delta * (fitness - mean);
+}
+
+void PopulationStatistics::remove(const uint8_t *chromosome, double fitness)
+{
+    --count;
+    for (int i = 0; i < chromosomeSize * 8; i++)
+        ones[i] -= (chromosome[i >> 3] >> (i & 7)) & 1;
+
+    if (!isfinite(fitness))
+        return;
+    if (--fitnessCount == 0)
+    {
+        mean = m2 = 0;
+        return;
+    }
+    double delta = fitness - mean;
+    mean -= delta / fitnessCount;
+    m2 -= delta * (fitness - mean);
+    if (m2 < 0) // rounding
+        m2 = 0;
+}
+
+void PopulationStatistics::merge(const PopulationStatistics &other)
+{
+    count += other.count;
+    for (size_t i = 0; i < ones.size(); i++)
+        ones[i] += other.ones[i];
+
+    if (other.fitnessCount == 0)
+        return;
+    // Chan et al. pairwise update
+    int64_t n = fitnessCount + other.fitnessCount;
+    double delta = other.mean - mean;
+    mean += delta * other.fitnessCount / n;
+    m2 += other.m2 + delta * delta * ((double)fitnessCount * other.fitnessCount / n);
+    fitnessCount = n;
+}
+
+double PopulationStatistics::getStandardDeviation() const
+{
+    return sqrt(getVariance());
+}
+
+double PopulationStatistics::getConvergedAllelesFraction(double threshold) const
+{
+    if (count == 0 || ones.empty())
+        return 0;
+    int64_t converged = 0;
+    for (int64_t n : ones)
+        if (n >= threshold * count || count - n >= threshold * count)
+            ++converged;
+    return (double)converged / ones.size();
+}
+
+double PopulationStatistics::getDiversity() const
+{
+    if (count < 2 || ones.empty())
+        return 0;
+    // A bit with c ones differs in c * (count - c) of the pairs.
+    double differences = 0;
+    for (int64_t n : ones)
+        differences += (double)n * (count - n);
+    return differences / ((double)count * (count - 1) / 2) / ones.size();
+}
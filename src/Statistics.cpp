@@ -0,0 +1,100 @@
+/**
+ * @file Statistics.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief Statistical tests are a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "Statistics.h"
+#include <math.h>
+#include <algorithm>
+
+double normalQuantile(double p)
+{
+    if (p > 0.5)
+        return -normalQuantile(1 - p);
+    double t = sqrt(-2 * log(p));
+    return -(t - (2.515517 + 0.802853 * t + 0.010328 * t * t) / (1 + 1.432788 * t + 0.189269 * t * t + 0.001308 * t * t * t));
+}
+
+double studentQuantile(double p, double df)
+{
+    if (df == 1)
+        return tan(3.14159265358979323846 * (p - 0.5));
+    if (df == 2)
+        return (2 * p - 1) / sqrt(2 * p * (1 - p));
+
+    double z = normalQuantile(p), z2 = z * z;
+    double g1 = (z2 + 1) * z / 4;
+    double g2 = ((5 * z2 + 16) * z2 + 3) * z / 96;
+    double g3 = (((3 * z2 + 19) * z2 + 17) * z2 - 15) * z / 384;
+    double g4 = ((((79 * z2 + 776) * z2 + 1482) * z2 - 1920) * z2 - 945) * z / 92160;
+    return z + g1 / df + g2 / (df * df) + g3 / (df * df * df) + g4 / (df * df * df * df);
+}
+
+double chiSquareQuantile(double p, double df)
+{
+    double h = 2 / (9 * df);
+    double x = 1 - h + normalQuantile(p) * sqrt(h);
+    return df * x * x * x;
+}
+
+bool friedmanRace(const vector<vector<double>> &results, double alpha, vector<bool> &eliminated, vector<double> &meanRanks)
+{
+    const int n = (int)results.size();
+    const int k = n ? (int)results[0].size() : 0;
+    eliminated.assign(k, false);
+    meanRanks.assign(k, 1);
+    if (n < 2 || k < 2)
+        return false;
+
+    // Rank the configurations in each block, ties share the mean rank.
+    vector<double> rankSums(k, 0);
+    double squares = 0;
+    vector<int> order(k);
+    for (auto &block : results)
+    {
+        for (int j = 0; j < k; j++)
+            order[j] = j;
+        sort(order.begin(), order.end(), [&block](int a, int b)
+             { return block[a] < block[b]; });
+        for (int first = 0; first < k;)
+        {
+            int last = first;
+            while (last + 1 < k && block[order[last + 1]] == block[order[first]])
+                ++last;
+            double rank = (first + last) / 2.0 + 1;
+            for (int j = first; j <= last; j++)
+            {
+                rankSums[order[j]] += rank;
+                squares += rank * rank;
+            }
+            first = last + 1;
+        }
+    }
+    for (int j = 0; j < k; j++)
+        meanRanks[j] = rankSums[j] / n;
+
+    const double c = n * k * (k + 1.0) * (k + 1.0) / 4;
+    if (squares - c <= 0) // every block is a tie
+        return false;
+
+    double spread = 0;
+    for (int j = 0; j < k; j++)
+        spread += (rankSums[j] - n * (k + 1.0) / 2) * (rankSums[j] - n * (k + 1.0) / 2);
+    double statistic = (k - 1) * spread / (squares - c);
+    if (statistic <= chiSquareQuantile(1 - alpha, k - 1))
+        return false;
+
+    // Post-hoc: compare every configuration with the best one (Conover).
+    int best = (int)(min_element(rankSums.begin(), rankSums.end()) - rankSums.begin());
+    double df = (n - 1.0) * (k - 1.0);
+    double deviation = sqrt(max(0.0, 2 * n * (1 - statistic / (n * (k - 1.0))) * (squares - c) / df));
+    double threshold = studentQuantile(1 - alpha / 2, df) * deviation;
+    for (int j = 0; j < k; j++)
+        eliminated[j] = (rankSums[j] - rankSums[best] > threshold);
+    return true;
+}
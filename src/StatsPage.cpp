@@ -0,0 +1,196 @@
+/**
+ * @file StatsPage.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief StatsPage Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "StatsPage.h"
+#include <string.h>
+#include <new>
+#include <thread>
+#include <algorithm>
+#if STATS_PAGE_SHM
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+static const char statsMagic[8] = {'G', 'A', 'S', 'T', 'A', 'T', 'S', '1'};
+static const uint32_t statsVersion = 1;
+static_assert(sizeof(StatsSnapshot) % 8 == 0, "The snapshot is made of 64-bit words");
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The page is shared between processes, its atomics must be lock-free");
+
+StatsPage::StatsPage()
+{
+    page = nullptr;
+    words = nullptr;
+    chromosomeSize = chromosomeWords = 0;
+    length = 0;
+    writer = false;
+    startTime = chrono::steady_clock::now();
+}
+
+StatsPage::~StatsPage()
+{
+    close();
+}
+
+bool StatsPage::create(const string &name, int chromosomeSize)
+{
+    close();
+#if STATS_PAGE_SHM
+    this->chromosomeSize = chromosomeSize;
+    chromosomeWords = (chromosomeSize + 7) / 8;
+    length = sizeof(Header) + 8 * (snapshotWords + chromosomeWords);
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return false;
+    void *p = ftruncate(fd, (off_t)length) == 0 ? mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if (p == MAP_FAILED)
+    {
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    page = (Header *)p;
+    words = (atomic<uint64_t> *)(page + 1);
+    this->name = name;
+    writer = true;
+    startTime = chrono::steady_clock::now();
+
+    // The segment starts zeroed: sequence 0, nothing published. The magic is written last, a monitor attaching earlier refuses the page.
+    page->version = statsVersion;
+    page->chromosomeSize = (uint32_t)chromosomeSize;
+    page->pid = (uint64_t)getpid();
+    new (&page->sequence) atomic<uint64_t>(0);
+    for (int i = 0; i < snapshotWords + chromosomeWords; i++)
+        new (&words[i]) atomic<uint64_t>(0);
+    atomic_thread_fence(memory_order_release);
+    memcpy(page->magic, statsMagic, sizeof(statsMagic));
+    return true;
+#else
+    (void)name;
+    (void)chromosomeSize;
+    return false;
+#endif
+}
+
+bool StatsPage::attach(const string &name)
+{
+    close();
+#if STATS_PAGE_SHM
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        return false;
+    struct stat status;
+    void *p = MAP_FAILED;
+    if (fstat(fd, &status) == 0 && (size_t)status.st_size >= sizeof(Header) + sizeof(StatsSnapshot))
+    {
+        length = (size_t)status.st_size;
+        p = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (p == MAP_FAILED)
+        return false;
+
+    page = (Header *)p;
+    words = (atomic<uint64_t> *)(page + 1);
+    this->name = name;
+    writer = false;
+    chromosomeSize = (int)page->chromosomeSize;
+    chromosomeWords = (chromosomeSize + 7) / 8;
+    if (memcmp(page->magic, statsMagic, sizeof(statsMagic)) != 0 || page->version != statsVersion ||
+        length < sizeof(Header) + 8 * (size_t)(snapshotWords + chromosomeWords))
+    {
+        close();
+        return false;
+    }
+    return true;
+#else
+    (void)name;
+    return false;
+#endif
+}
+
+void StatsPage::close()
+{
+#if STATS_PAGE_SHM
+    if (page != nullptr)
+    {
+        munmap(page, length);
+        if (writer)
+            shm_unlink(name.c_str());
+    }
+#endif
+    page = nullptr;
+    words = nullptr;
+    writer = false;
+}
+
+void StatsPage::publish(const StatsSnapshot &snapshot, const void *chromosome)
+{
+    if (page == nullptr || !writer)
+        return;
+    uint64_t buffer[snapshotWords];
+    memcpy(buffer, &snapshot, sizeof(snapshot));
+
+    uint64_t s = page->sequence.load(memory_order_relaxed);
+    page->sequence.store(s + 1, memory_order_relaxed); // odd: writing
+    atomic_thread_fence(memory_order_release);
+    for (int i = 0; i < snapshotWords; i++)
+        words[i].store(buffer[i], memory_order_relaxed);
+    const uint8_t *bytes = (const uint8_t *)chromosome;
+    for (int i = 0; i < chromosomeWords; i++)
+    {
+        uint64_t word = 0;
+        memcpy(&word, bytes + 8 * i, min(8, chromosomeSize - 8 * i));
+        words[snapshotWords + i].store(word, memory_order_relaxed);
+    }
+    page->sequence.store(s + 2, memory_order_release);
+}
+
+bool StatsPage::read(StatsSnapshot &snapshot, void *chromosome, uint64_t *version) const
+{
+    if (page == nullptr)
+        return false;
+    uint64_t buffer[snapshotWords];
+    for (int attempt = 0; attempt < 1000; attempt++)
+    {
+        uint64_t s = page->sequence.load(memory_order_acquire);
+        if (s == 0)
+            return false;
+        if (s & 1)
+        {
+            this_thread::yield();
+            continue;
+        }
+        for (int i = 0; i < snapshotWords; i++)
+            buffer[i] = words[i].load(memory_order_relaxed);
+        uint8_t *bytes = (uint8_t *)chromosome;
+        for (int i = 0; chromosome && i < chromosomeWords; i++)
+        {
+            uint64_t word = words[snapshotWords + i].load(memory_order_relaxed);
+            memcpy(bytes + 8 * i, &word, min(8, chromosomeSize - 8 * i));
+        }
+        atomic_thread_fence(memory_order_acquire);
+        if (page->sequence.load(memory_order_relaxed) != s)
+            continue;
+
+        memcpy(&snapshot, buffer, sizeof(snapshot));
+        if (version)
+            *version = s / 2;
+        return true;
+    }
+    return false;
+}
+
+uint64_t StatsPage::getWriterPid()
+{
+    return page ? page->pid : 0;
+}
@@ -9,6 +9,7 @@
  */
 
 #include "TerminationConditions.h"
+#include <math.h>
 
 void TerminationConditions::setFitnessGoal(double goal)
 {
@@ -33,6 +34,33 @@ void TerminationConditions::setMaxGeneration(uint64_t maxGeneration)
     this->maxGeneration = maxGeneration;
 }
 
+void TerminationConditions::setMinDiversity(double minDiversity)
+{
+    this->minDiversity = minDiversity;
+    enableDiversity = true;
+}
+
+void TerminationConditions::setFitnessBand(double relativeWidth)
+{
+    this->relativeWidth = relativeWidth;
+    enableFitnessBand = true;
+}
+
+void TerminationConditions::setMinImprovementSlope(double minSlope, uint64_t window)
+{
+    this->minSlope = minSlope;
+    slopeWindow = window < 2 ? 2 : window;
+    resetSlope();
+    enableSlope = true;
+}
+
+void TerminationConditions::setMaxConvergedAlleles(double fraction, double threshold)
+{
+    convergedFraction = fraction;
+    alleleThreshold = threshold;
+    enableAlleles = true;
+}
+
 void TerminationConditions::setStartTime(chrono::high_resolution_clock::time_point startTime)
 {
     this->startTime = startTime;
@@ -85,3 +113,71 @@ bool TerminationConditions::checkIterationsCondition(double bestFitness)
     ++iterations;
     return iterations >= maxIterations;
 }
+
+bool TerminationConditions::checkDiversityCondition(double diversity)
+{
+    if (!enableDiversity)
+        return false;
+    return diversity < minDiversity;
+}
+
+bool TerminationConditions::checkFitnessBandCondition(double mean, double standardDeviation)
+{
+    if (!enableFitnessBand)
+        return false;
+    return standardDeviation <= relativeWidth * fabs(mean);
+}
+
+void TerminationConditions::resetSlope()
+{
+    slopeValues.clear();
+    slopeNext = 0;
+    slopeSumY = slopeSumXY = 0;
+}
+
+bool TerminationConditions::checkSlopeCondition(double bestFitness)
+{
+    if (!enableSlope || !isfinite(bestFitness))
+        return false;
+
+    const size_t w = slopeWindow;
+    if (slopeValues.size() < w)
+    {
+        slopeSumY += bestFitness;
+        slopeSumXY += slopeValues.size() * bestFitness;
+        slopeValues.push_back(bestFitness);
+        if (slopeValues.size() < w)
+            return false;
+    }
+    else
+    {
+        // Slide the window: every x goes down by one, the oldest value leaves and the new one comes at x = w - 1.
+        double oldest = slopeValues[slopeNext];
+        slopeSumXY += (w - 1) * bestFitness - (slopeSumY - oldest);
+        slopeSumY += bestFitness - oldest;
+        slopeValues[slopeNext] = bestFitness;
+        slopeNext = (slopeNext + 1) % w;
+        if (slopeNext == 0)
+        {
+            // Sum again once per window, so the rounding errors do not build up.
+            slopeSumY = slopeSumXY = 0;
+            for (size_t x = 0; x < w; x++)
+            {
+                slopeSumY += slopeValues[x];
+                slopeSumXY += x * slopeValues[x];
+            }
+        }
+    }
+
+    double n = (double)w;
+    double sumX = n * (n - 1) / 2, sumXX = (n - 1) * n * (2 * n - 1) / 6;
+    double slope = (n * slopeSumXY - sumX * slopeSumY) / (n * sumXX - sumX * sumX);
+    return (maximizeFitness ? slope : -slope) < minSlope;
+}
+
+bool TerminationConditions::checkAllelesCondition(double convergedFraction)
+{
+    if (!enableAlleles)
+        return false;
+    return convergedFraction >= this->convergedFraction;
+}
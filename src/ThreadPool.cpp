@@ -0,0 +1,131 @@
+/**
+ * @file ThreadPool.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief ThreadPool Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "ThreadPool.h"
+#include "NumaTopology.h"
+#include <atomic>
+#include <memory>
+
+ThreadPool::ThreadPool(int threadsCount, bool pinThreads)
+{
+    if (threadsCount <= 0)
+        threadsCount = max(1, (int)thread::hardware_concurrency());
+
+    stopping = false;
+    for (int i = 1; i < threadsCount; i++)
+        workers.push_back(thread(&ThreadPool::workerLoop, this));
+    if (!pinThreads)
+        return;
+
+    // The calling thread is thread 0 and stays where it is, the pool threads take the next CPUs of the placement.
+    NumaTopology topology;
+    vector<int> cpus = topology.place(threadsCount);
+    placement = "NUMA nodes: " + to_string(topology.nodesCount()) + "\n";
+    for (int node = 0; node < topology.nodesCount(); node++)
+        placement += "node " + to_string(node) + ": " + to_string(topology.getCpus(node).size()) + " cpus\n";
+    placement += "thread 0: calling thread, not pinned\n";
+    for (int i = 1; i < threadsCount; i++)
+    {
+        placement += "thread " + to_string(i) + ": ";
+        if (NumaTopology::pin(workers[i - 1], cpus[i]))
+            placement += "cpu " + to_string(cpus[i]) + ", node " + to_string(topology.getNode(cpus[i])) + "\n";
+        else
+            placement += "not pinned\n";
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<mutex> lock(tasksMutex);
+        stopping = true;
+    }
+    tasksCondition.notify_all();
+    for (auto &worker : workers)
+        worker.join();
+}
+
+void ThreadPool::workerLoop()
+{
+    for (;;)
+    {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(tasksMutex);
+            tasksCondition.wait(lock, [this]
+                                { return stopping || !tasks.empty(); });
+            if (tasks.empty())
+                return;
+            task = move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+void ThreadPool::submit(function<void()> task)
+{
+    {
+        lock_guard<mutex> lock(tasksMutex);
+        tasks.push(move(task));
+    }
+    tasksCondition.notify_one();
+}
+
+void ThreadPool::parallelFor(int begin, int end, function<void(int)> task)
+{
+    if (begin >= end)
+        return;
+    if (workers.empty() || end - begin == 1)
+    {
+        for (int i = begin; i < end; i++)
+            task(i);
+        return;
+    }
+
+    // Helpers may start after the loop is over, so the state is shared with them.
+    struct State
+    {
+        atomic<int> next;
+        atomic<int> done;
+        int end;
+        function<void(int)> task;
+        mutex doneMutex;
+        condition_variable doneCondition;
+    };
+    shared_ptr<State> state = make_shared<State>();
+    state->next = begin;
+    state->done = 0;
+    state->end = end;
+    state->task = task;
+    const int count = end - begin;
+
+    auto run = [state, count]()
+    {
+        for (int i = state->next++; i < state->end; i = state->next++)
+        {
+            state->task(i);
+            if (++state->done == count)
+            {
+                lock_guard<mutex> lock(state->doneMutex);
+                state->doneCondition.notify_all();
+            }
+        }
+    };
+
+    int helpers = min((int)workers.size(), count - 1);
+    for (int i = 0; i < helpers; i++)
+        submit(run);
+    run();
+
+    unique_lock<mutex> lock(state->doneMutex);
+    state->doneCondition.wait(lock, [&state, count]
+                              { return state->done == count; });
+}
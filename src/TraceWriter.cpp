@@ -0,0 +1,131 @@
+/**
+ * @file TraceWriter.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief TraceWriter Class is a part of the Genetic Algorithm library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "TraceWriter.h"
+#include <string.h>
+
+static const char traceMagic[8] = {'G', 'A', 'T', 'R', 'A', 'C', 'E', '1'};
+static const uint32_t traceVersion = 1;
+
+TraceWriter::TraceWriter(const string &path, TraceFormat format, int capacity, double flushInterval_ms)
+    : format(format), buffer(capacity > 0 ? capacity : 1), head(0), tail(0), dropped(0), stopping(false)
+{
+    startTime = chrono::steady_clock::now();
+    flushInterval = chrono::nanoseconds((int64_t)(flushInterval_ms * 1e6));
+    file = fopen(path.c_str(), format == TraceBinary ? "wb" : "w");
+    if (file == nullptr)
+        return;
+
+    if (format == TraceBinary)
+    {
+        uint32_t recordSize = sizeof(GenerationRecord);
+        fwrite(traceMagic, 1, sizeof(traceMagic), file);
+        fwrite(&traceVersion, sizeof(traceVersion), 1, file);
+        fwrite(&recordSize, sizeof(recordSize), 1, file);
+    }
+    else
+        fputs("generation,start_ns,end_ns,best,mean,worst,diversity,evaluations,rank_ns,local_search_ns,breed_ns,dedup_ns\n", file);
+    writer = thread(&TraceWriter::writerLoop, this);
+}
+
+TraceWriter::~TraceWriter()
+{
+    if (file == nullptr)
+        return;
+    {
+        lock_guard<mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_one();
+    writer.join();
+    fclose(file);
+}
+
+bool TraceWriter::push(const GenerationRecord &record)
+{
+    if (file == nullptr)
+        return false;
+    uint64_t h = head.load(memory_order_relaxed);
+    if (h - tail.load(memory_order_acquire) == buffer.size())
+    {
+        dropped.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    buffer[h % buffer.size()] = record;
+    head.store(h + 1, memory_order_release);
+    return true;
+}
+
+void TraceWriter::flush()
+{
+    if (file == nullptr)
+        return;
+    uint64_t h = head.load(memory_order_relaxed);
+    while (tail.load(memory_order_acquire) < h)
+    {
+        wakeCondition.notify_one();
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+}
+
+void TraceWriter::writerLoop()
+{
+    unique_lock<mutex> lock(wakeMutex);
+    while (!stopping)
+    {
+        wakeCondition.wait_for(lock, flushInterval);
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+    lock.unlock();
+    drain();
+}
+
+void TraceWriter::drain()
+{
+    uint64_t t = tail.load(memory_order_relaxed);
+    const uint64_t h = head.load(memory_order_acquire);
+    if (t == h)
+        return;
+
+    for (; t < h; t++)
+    {
+        const GenerationRecord &r = buffer[t % buffer.size()];
+        if (format == TraceBinary)
+            fwrite(&r, sizeof(r), 1, file);
+        else
+            fprintf(file, "%llu,%lld,%lld,%.17g,%.17g,%.17g,%.17g,%llu,%lld,%lld,%lld,%lld\n",
+                    (unsigned long long)r.generation, (long long)r.start_ns, (long long)r.end_ns, r.bestFitness, r.meanFitness, r.worstFitness,
+                    r.diversity, (unsigned long long)r.evaluations, (long long)r.rank_ns, (long long)r.localSearch_ns, (long long)r.breed_ns,
+                    (long long)r.dedup_ns);
+    }
+    fflush(file);
+    tail.store(t, memory_order_release);
+}
+
+bool TraceWriter::read(const string &path, vector<GenerationRecord> &records)
+{
+    records.clear();
+    FILE *f = fopen(path.c_str(), "rb");
+    if (f == nullptr)
+        return false;
+
+    char magic[8];
+    uint32_t version = 0, recordSize = 0;
+    bool ok = fread(magic, 1, sizeof(magic), f) == sizeof(magic) && memcmp(magic, traceMagic, sizeof(magic)) == 0 &&
+              fread(&version, sizeof(version), 1, f) == 1 && version == traceVersion &&
+              fread(&recordSize, sizeof(recordSize), 1, f) == 1 && recordSize == sizeof(GenerationRecord);
+    GenerationRecord record;
+    while (ok && fread(&record, sizeof(record), 1, f) == 1)
+        records.push_back(record);
+    fclose(f);
+    return ok;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file test_async_fitness.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test asynchronous fitness evaluation against a stand-in simulator
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+#include <atomic>
+
+using namespace std;
+
+char password[] = "Async fitness";
+
+const int p_size = sizeof(password) - 1; // -1 to ignore '\0' char
+const int maxInFlight = 16;
+
+struct Chromosome
+{
+    char c[p_size];
+};
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    double scoure = 0;
+    for (int i = 0; i < p_size; i++)
+        if (chromosome.c[i] == password[i])
+            ++scoure;
+
+    return scoure;
+}
+
+// Stand-in for a simulator: a single thread answering the submitted jobs, the later of two first
+struct Job
+{
+    Chromosome *chromosome;
+    function<void(double)> done;
+};
+BoundedQueue<Job> jobs(1 << 20);
+atomic<int> inFlight(0), maxSeen(0), errors(0);
+
+void answer(Job &job)
+{
+    double fitness = fitnessFunction(*job.chromosome);
+    --inFlight;
+    job.done(fitness);
+}
+
+void simulator()
+{
+    Job job, next;
+    while (jobs.pop(job))
+    {
+        this_thread::yield(); // the job takes some time
+        if (jobs.tryPop(next))
+            answer(next);
+        answer(job);
+    }
+}
+
+void asyncFitnessFunction(Chromosome &chromosome, function<void(double)> done)
+{
+    int now = ++inFlight;
+    if (now > maxInFlight)
+        ++errors;
+    for (int seen = maxSeen; now > seen && !maxSeen.compare_exchange_weak(seen, now);)
+        ;
+    jobs.push(Job{&chromosome, done});
+}
+
+int main()
+{
+    thread simulatorThread(simulator);
+
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 200, 2, 15, Selection::MixSelection, Crossover::MixCrossover);
+    ga.setAsyncFitnessFunction(asyncFitnessFunction, maxInFlight);
+    ga.initializePopulation(200);
+    ga.terminationConditions.setFitnessGoal(p_size);
+    auto bestIndividual = ga.solve();
+
+    jobs.close();
+    simulatorThread.join();
+
+    if (errors != 0 || maxSeen < 2)
+        return 1;
+    if (bestIndividual.getFitness() != fitnessFunction(*(Chromosome *)bestIndividual.getChromosomePointer()))
+        return 1;
+    // Each result goes to its own chromosome, whatever the order of the answers.
+    for (auto &individual : ga.getPopulation())
+        if (individual.getFitness() != fitnessFunction(*(Chromosome *)individual.getChromosomePointer()))
+            return 1;
+    return 0;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file test_bounded_fitness.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test that the offspring rejected by a bounded fitness function sort last and are never chosen over an exact fitness
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+#include <atomic>
+
+using namespace std;
+
+struct Chromosome
+{
+    uint8_t genes[32];
+};
+
+bool maximize = true;
+atomic<int> exact(0), rejected(0);
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    double scoure = 0;
+    for (int i = 0; i < 32; i++)
+        scoure += chromosome.genes[i];
+    return scoure;
+}
+
+// Stop as soon as the remaining genes can not reach the cutoff
+double boundedFitnessFunction(Chromosome &chromosome, double cutoff)
+{
+    double scoure = 0;
+    for (int i = 0; i < 32; i++)
+    {
+        scoure += chromosome.genes[i];
+        if (maximize ? scoure + 255.0 * (31 - i) < cutoff : scoure > cutoff)
+        {
+            ++rejected;
+            return REJECTED_FITNESS;
+        }
+    }
+    ++exact;
+    return scoure;
+}
+
+double rejectAll(Chromosome &, double)
+{
+    ++rejected;
+    return REJECTED_FITNESS;
+}
+
+// The rejected individuals are last with the worst fitness, the others hold their exact fitness
+bool checkPopulation(vector<Individual<Chromosome>> population, Individual<Chromosome> best)
+{
+    const double worst = maximize ? -HUGE_VAL : HUGE_VAL;
+    bool seenRejected = false;
+    double bestExact = worst;
+    for (auto &individual : population)
+    {
+        Chromosome chromosome = individual.getChromosome();
+        if (individual.isRejected())
+        {
+            seenRejected = true;
+            if (individual.getFitness() != worst)
+                return false;
+            continue;
+        }
+        if (seenRejected || individual.getFitness() != fitnessFunction(chromosome))
+            return false;
+        bestExact = maximize ? max(bestExact, individual.getFitness()) : min(bestExact, individual.getFitness());
+    }
+    Chromosome chromosome = best.getChromosome();
+    return !best.isRejected() && best.getFitness() == bestExact && best.getFitness() == fitnessFunction(chromosome);
+}
+
+bool testBounded(bool maximizeFitness, Selection selection, double cutoffPercentage)
+{
+    maximize = maximizeFitness;
+    exact = rejected = 0;
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, maximize, 60, 2, 15, selection, Crossover::MixCrossover);
+    ga.setVerbose(false);
+    ga.setSeed(5);
+    ga.setBoundedFitnessFunction(boundedFitnessFunction, cutoffPercentage);
+    ga.initializePopulation(200);
+    Individual<Chromosome> best = ga.solve();
+    return rejected > 0 && exact > 0 && checkPopulation(ga.getPopulation(), best);
+}
+
+// Every offspring is rejected: the best stays the best of the initial population
+bool testRejectAll(Selection selection)
+{
+    maximize = true;
+    rejected = 0;
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 20, 2, 15, selection, Crossover::MixCrossover);
+    ga.setVerbose(false);
+    ga.setSeed(6);
+    ga.initializePopulation(100);
+    double initialBest = -HUGE_VAL;
+    for (auto &individual : ga.getPopulation())
+        initialBest = max(initialBest, individual.getFitness());
+    ga.setBoundedFitnessFunction(rejectAll);
+    Individual<Chromosome> best = ga.solve();
+
+    Chromosome chromosome;
+    double fitness;
+    return rejected > 0 && best.getFitness() == initialBest && checkPopulation(ga.getPopulation(), best) &&
+           ga.getBestSoFar(chromosome, fitness) && fitness == initialBest;
+}
+
+int main()
+{
+    if (!testBounded(true, Selection::MixSelection, -1) || !testBounded(true, Selection::RouletteWheel, 100) ||
+        !testBounded(false, Selection::Fast, 50))
+        return 1;
+    if (!testRejectAll(Selection::Fast) || !testRejectAll(Selection::RouletteWheel))
+        return 1;
+    return 0;
+}
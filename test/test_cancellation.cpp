@@ -0,0 +1,112 @@
+/**
+ * @file test_cancellation.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test cancelling solve() and reading the best so far from another thread
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+#include <thread>
+
+using namespace std;
+
+struct Chromosome
+{
+    uint8_t genes[64];
+};
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    double scoure = 0;
+    for (int repeat = 0; repeat < 50; repeat++) // make the evaluation take some time
+        for (int i = 0; i < 64; i++)
+            scoure += (chromosome.genes[i] ^ (uint8_t)repeat) % 5;
+    return scoure;
+}
+
+double elapsed_ms(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Solve until the deadline of the token while another thread reads the best so far, return false on failure
+bool run(int threadsCount, bool pipelined)
+{
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 200, 2, 15);
+    ga.setVerbose(false);
+    ga.setThreadsCount(threadsCount);
+    ga.setPipelinedEvaluation(pipelined, 16);
+    ga.terminationConditions.setMaxGeneration(-1);
+    shared_ptr<CancellationToken> token = make_shared<CancellationToken>();
+    ga.setCancellationToken(token);
+    ga.initializePopulation(200);
+
+    atomic<bool> solving(true), ok(true);
+    thread reader([&]()
+                  {
+                      double lastFitness = -1;
+                      uint64_t lastVersion = 0;
+                      while (solving)
+                      {
+                          Chromosome chromosome;
+                          double fitness;
+                          uint64_t version;
+                          if (!ga.getBestSoFar(chromosome, fitness, &version))
+                              continue;
+                          // A torn read would not match its fitness.
+                          if (fitnessFunction(chromosome) != fitness || fitness < lastFitness || version < lastVersion)
+                              ok = false;
+                          lastFitness = fitness;
+                          lastVersion = version;
+                      } });
+
+    auto start = chrono::steady_clock::now();
+    token->setDeadlineAfter_ms(100);
+    Individual<Chromosome> best = ga.solve();
+    double solve_ms = elapsed_ms(start);
+    solving = false;
+    reader.join();
+
+    Chromosome chromosome;
+    double fitness;
+    if (!ga.getBestSoFar(chromosome, fitness) || fitness != best.getFitness() || fitnessFunction(chromosome) != fitness)
+        ok = false;
+    if (solve_ms > 2000)
+        ok = false;
+    return ok;
+}
+
+bool cancelFromAnotherThread()
+{
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 200, 2, 15);
+    ga.setVerbose(false);
+    ga.terminationConditions.setMaxGeneration(-1);
+    shared_ptr<CancellationToken> token = make_shared<CancellationToken>();
+    ga.setCancellationToken(token);
+    ga.initializePopulation(200);
+
+    thread canceller([&token]()
+                     {
+                         this_thread::sleep_for(chrono::milliseconds(100));
+                         token->cancel(); });
+    auto start = chrono::steady_clock::now();
+    Individual<Chromosome> best = ga.solve();
+    double solve_ms = elapsed_ms(start);
+    canceller.join();
+
+    Chromosome chromosome;
+    double fitness;
+    return solve_ms < 2000 && ga.getBestSoFar(chromosome, fitness) && fitness == best.getFitness();
+}
+
+int main()
+{
+    if (!run(1, false) || !run(4, true))
+        return 1;
+    if (!cancelFromAnotherThread())
+        return 1;
+    return 0;
+}
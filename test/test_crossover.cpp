@@ -0,0 +1,99 @@
+/**
+ * @file test_crossover.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the cut points of the one-point and two-point crossovers and the gene layout
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+struct Tour
+{
+    uint8_t city[13];
+};
+
+struct Point
+{
+    int32_t x[4];
+    double weight;
+    uint16_t id;
+};
+
+double tourFitness(Tour &tour)
+{
+    double scoure = 0;
+    for (int i = 0; i < 13; i++)
+        scoure += tour.city[i] % 13;
+    return scoure;
+}
+
+double pointFitness(Point &point)
+{
+    return (double)point.x[0] - point.x[1] + point.id;
+}
+
+// Number of individuals of %population% that are not a copy of one of %initial%
+template <class T>
+int countNew(vector<Individual<T>> &population, vector<Individual<T>> &initial)
+{
+    int count = 0;
+    for (auto &individual : population)
+    {
+        bool copy = false;
+        for (auto &old : initial)
+            copy = copy || memcmp(individual.getChromosomePointer(), old.getChromosomePointer(), sizeof(T)) == 0;
+        count += !copy;
+    }
+    return count;
+}
+
+int main()
+{
+    // A short chromosome in a large population: the cuts must fall inside the chromosome, so most offspring mix their parents.
+    GeneticAlgorithm<Tour> tours(tourFitness, true, 1, 0, 15, Selection::Fast, Crossover::OnePoint);
+    tours.setVerbose(false);
+    tours.setSeed(3);
+    tours.initializePopulation(500);
+    vector<Individual<Tour>> initial = tours.getPopulation();
+    tours.step(1);
+    vector<Individual<Tour>> next = tours.getPopulation();
+    if (countNew(next, initial) < (int)next.size() / 2)
+        return 1;
+
+    // With a gene layout each gene of an offspring comes whole from one parent.
+    GeneLayout layout;
+    layout.addArray(GENE_ARRAY(Point, x)).add(GENE_FIELD(Point, weight)).add(GENE_FIELD(Point, id));
+    if (layout.size() != 6 || !layout.isValid(sizeof(Point)) || layout.getOffset(4) != offsetof(Point, weight))
+        return 1;
+
+    Crossover methods[] = {Crossover::OnePoint, Crossover::TwoPoint};
+    for (Crossover method : methods)
+    {
+        GeneticAlgorithm<Point> points(pointFitness, true, 1, 0, 15, Selection::Fast, method);
+        points.setVerbose(false);
+        points.setSeed(5);
+        points.setGeneLayout(layout);
+        points.initializePopulation(100);
+        vector<Individual<Point>> parents = points.getPopulation();
+        points.step(1);
+        vector<Individual<Point>> offspring = points.getPopulation();
+        if (countNew(offspring, parents) == 0)
+            return 1;
+
+        for (auto &individual : offspring)
+            for (int g = 0; g < layout.size(); g++)
+            {
+                bool inherited = false;
+                for (auto &parent : parents)
+                    inherited = inherited || memcmp(individual.getChromosomePointer() + layout.getOffset(g), parent.getChromosomePointer() + layout.getOffset(g), layout.getSize(g)) == 0;
+                if (!inherited)
+                    return 1;
+            }
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file test_delta_fitness.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test delta fitness evaluation
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+char password[] = "Delta fitness evaluation";
+
+const int p_size = sizeof(password) - 1; // -1 to ignore '\0' char
+
+struct Chromosome
+{
+    char c[p_size];
+};
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    double scoure = 0;
+    for (int i = 0; i < p_size; i++)
+        if (chromosome.c[i] == password[i])
+            ++scoure;
+
+    return scoure;
+}
+
+int deltaCalls = 0, mismatches = 0;
+
+double deltaFitnessFunction(Chromosome &chromosome, Chromosome &parent, double parentFitness, const vector<pair<int, int>> &modifiedRanges)
+{
+    ++deltaCalls;
+    // Sorted, disjoint and inside the chromosome
+    for (size_t r = 0; r < modifiedRanges.size(); r++)
+        if (modifiedRanges[r].first >= modifiedRanges[r].second || modifiedRanges[r].second > p_size ||
+            (r > 0 && modifiedRanges[r].first <= modifiedRanges[r - 1].second))
+            ++mismatches;
+    double scoure = parentFitness;
+    for (auto &range : modifiedRanges)
+        for (int i = range.first; i < range.second; i++)
+            scoure += (chromosome.c[i] == password[i]) - (parent.c[i] == password[i]);
+
+    if (scoure != fitnessFunction(chromosome))
+        ++mismatches;
+    return scoure;
+}
+
+bool run(Crossover crossover, uint64_t maxGeneration)
+{
+    deltaCalls = mismatches = 0;
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, maxGeneration, 2, 15, Selection::MixSelection, crossover);
+    ga.setVerbose(false);
+    ga.setDeltaFitnessFunction(deltaFitnessFunction);
+    ga.initializePopulation(300);
+    ga.terminationConditions.setFitnessGoal(p_size);
+    auto bestIndividual = ga.solve();
+
+    if (deltaCalls == 0 || mismatches != 0)
+        return false;
+    return bestIndividual.getFitness() == fitnessFunction(*(Chromosome *)bestIndividual.getChromosomePointer());
+}
+
+int main()
+{
+    // The uniform crossover compares the bytes, the one-point and two-point crossovers record the changed ranges.
+    if (!run(Crossover::MixCrossover, 2000) || !run(Crossover::OnePoint, 300) || !run(Crossover::TwoPoint, 300))
+        return 1;
+
+    return 0;
+}
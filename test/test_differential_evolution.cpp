@@ -0,0 +1,111 @@
+/**
+ * @file test_differential_evolution.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the Differential Evolution engine
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+const int sz = 10;
+
+struct Point
+{
+    double x[sz];
+};
+
+// Minimum 0 at (1, 2, ..., 10)
+double sphere(Point &point)
+{
+    double sum = 0;
+    for (int i = 0; i < sz; i++)
+        sum += (point.x[i] - (i + 1)) * (point.x[i] - (i + 1));
+    return sum;
+}
+
+bool inBounds(DifferentialEvolution<Point> &de)
+{
+    for (auto &individual : de.getPopulation())
+        for (int i = 0; i < sz; i++)
+            if (individual.getChromosome().x[i] < -20 || individual.getChromosome().x[i] > 20)
+                return false;
+    return true;
+}
+
+Individual<Point> run(DEStrategy strategy, int threads, uint64_t &evaluations, bool &valid)
+{
+    DifferentialEvolution<Point> de(sphere, false, -20, 20, 3000, strategy);
+    de.setVerbose(false);
+    de.setSeed(5);
+    de.setThreadsCount(threads);
+    de.terminationConditions.setFitnessGoal(1e-8);
+    de.initializePopulation(40);
+    Individual<Point> best = de.solve();
+    evaluations = de.getEvaluationsCount();
+    valid = inBounds(de) && best.getFitness() == sphere(*(Point *)best.getChromosomePointer());
+    return best;
+}
+
+double peak(float x)
+{
+    if (isnan(x) || isinf(x) || x > 205 || x < -205)
+        return -1e9;
+    return x * (0.4 + sin(x / 2));
+}
+
+int main()
+{
+    if (DifferentialEvolution<Point>::dimensions() != sz || DifferentialEvolution<float>::dimensions() != 1)
+        return 1;
+
+    // Every strategy reaches the goal with valid individuals
+    DEStrategy strategies[] = {RandOneBin, BestOneBin, CurrentToPBest};
+    for (DEStrategy strategy : strategies)
+    {
+        uint64_t evaluations;
+        bool valid;
+        Individual<Point> best = run(strategy, 1, evaluations, valid);
+        if (!valid || best.getFitness() > 1e-8 || evaluations >= 40ULL * 3001)
+            return 1;
+    }
+
+    // The same seed gives the same run on any number of threads
+    uint64_t evaluations1, evaluations4;
+    bool valid1, valid4;
+    Individual<Point> best1 = run(CurrentToPBest, 1, evaluations1, valid1);
+    Individual<Point> best4 = run(CurrentToPBest, 4, evaluations4, valid4);
+    if (!valid4 || evaluations1 != evaluations4 || memcmp(best1.getChromosomePointer(), best4.getChromosomePointer(), sizeof(Point)) != 0)
+        return 1;
+
+    // The adaptation moves the means away from their start values
+    DifferentialEvolution<Point> de(sphere, false, -20, 20, 50);
+    de.setVerbose(false);
+    de.setSeed(5);
+    de.initializePopulation(40);
+    de.solve();
+    if (de.getMeanF() == 0.8 || de.getMeanCR() == 0.9 || de.getGeneration() != 50)
+        return 1;
+
+    // The same fitness function as the GA, with far fewer evaluations
+    GeneticAlgorithm<float> ga(peak, true, 1500, 2, 30);
+    ga.setVerbose(false);
+    ga.setSeed(5);
+    ga.initializePopulation(500);
+    ga.terminationConditions.setFitnessGoal(285.9);
+    Individual<float> gaBest = ga.solve();
+
+    DifferentialEvolution<float> de1(peak, true, -205, 205, 1500);
+    de1.setVerbose(false);
+    de1.setSeed(5);
+    de1.initializePopulation(30);
+    de1.terminationConditions.setFitnessGoal(285.9);
+    Individual<float> deBest = de1.solve();
+    if (deBest.getFitness() < 285.9 || (gaBest.getFitness() >= 285.9 && de1.getEvaluationsCount() >= ga.getEvaluationsCount()))
+        return 1;
+    return 0;
+}
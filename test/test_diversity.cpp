@@ -0,0 +1,108 @@
+/**
+ * @file test_diversity.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the population diversity and the min diversity termination condition
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+struct Chromosome
+{
+    uint8_t genes[12];
+};
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    double scoure = 0;
+    for (int i = 0; i < 12; i++)
+        scoure += __builtin_popcount(chromosome.genes[i]);
+    return scoure;
+}
+
+// %ones% chromosomes with every bit set, the others with none
+vector<Individual<Chromosome>> twoGroups(int size, int ones)
+{
+    vector<Individual<Chromosome>> population;
+    for (int i = 0; i < size; i++)
+    {
+        Chromosome chromosome;
+        memset(&chromosome, i < ones ? 0xFF : 0, sizeof(chromosome));
+        population.push_back(Individual<Chromosome>(fitnessFunction, chromosome));
+    }
+    return population;
+}
+
+bool testDiversity()
+{
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction);
+    ga.setVerbose(false);
+    ga.setSeed(3);
+
+    // 10 x 10 pairs of the 190 differ in every bit
+    vector<Individual<Chromosome>> population = twoGroups(20, 10);
+    ga.initializePopulation(population);
+    if (fabs(ga.getDiversity(-1) - 100.0 / 190) > 1e-12 || ga.getDiversity(190) != ga.getDiversity(-1))
+        return false;
+    double sampled = ga.getDiversity(500);
+    if (sampled <= 0 || sampled >= 1 || fabs(sampled - 100.0 / 190) > 0.1)
+        return false;
+
+    // The same chromosome everywhere
+    population = twoGroups(20, 0);
+    ga.initializePopulation(population);
+    if (ga.getDiversity(-1) != 0 || ga.getDiversity(50) != 0)
+        return false;
+
+    // Random chromosomes differ in half of their bits
+    ga.initializePopulation(200);
+    double exact = ga.getDiversity(-1);
+    return fabs(exact - 0.5) < 0.01 && fabs(ga.getDiversity() - exact) < 0.03;
+}
+
+bool testMinDiversity()
+{
+    // A converged population stops before its first generation.
+    GeneticAlgorithm<Chromosome> converged(fitnessFunction, true, 100);
+    converged.setVerbose(false);
+    converged.terminationConditions.setMinDiversity(0.01);
+    vector<Individual<Chromosome>> population = twoGroups(30, 0);
+    converged.initializePopulation(population);
+    converged.step(100);
+    if (!converged.isTerminated() || converged.getGeneration() != 0)
+        return false;
+
+    // The population converges on the optimum long before the max generation.
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 5000, 0.5, 20);
+    ga.setVerbose(false);
+    ga.setSeed(4);
+    ga.terminationConditions.setMinDiversity(0.05);
+    ga.initializePopulation(60);
+    if (ga.getDiversity(-1) < 0.4)
+        return false;
+    ga.solve();
+    // The condition uses the exact diversity
+    if (ga.getGeneration() == 0 || ga.getGeneration() >= 5000 || ga.getDiversity(-1) >= 0.05 ||
+        fabs(ga.getPopulationStatistics().getDiversity() - ga.getDiversity(-1)) > 1e-12)
+        return false;
+
+    // Without the condition the same run goes to the max generation.
+    GeneticAlgorithm<Chromosome> unbounded(fitnessFunction, true, 300, 0.5, 20);
+    unbounded.setVerbose(false);
+    unbounded.setSeed(4);
+    unbounded.initializePopulation(60);
+    unbounded.solve();
+    return unbounded.getGeneration() == 300;
+}
+
+int main()
+{
+    if (!testDiversity() || !testMinDiversity())
+        return 1;
+    return 0;
+}
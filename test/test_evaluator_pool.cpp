@@ -0,0 +1,146 @@
+/**
+ * @file test_evaluator_pool.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the out-of-process evaluator pool with hanging and crashing fitness functions
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+#include <stdlib.h>
+#include <mutex>
+#include <condition_variable>
+#if EVALUATOR_POOL_PROCESSES
+#include <signal.h>
+#endif
+
+using namespace std;
+
+struct Chromosome
+{
+    uint8_t value;
+    uint8_t padding[7];
+};
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    if (chromosome.value == 13) // crash
+        abort();
+    if (chromosome.value == 42) // hang
+        for (;;)
+            this_thread::sleep_for(chrono::seconds(1));
+    return chromosome.value;
+}
+
+// A lock that another thread of the caller holds while the workers are respawned
+mutex shared;
+
+double lockingFitnessFunction(Chromosome &chromosome)
+{
+    if (chromosome.value == 13) // crash, the worker is respawned
+        abort();
+    lock_guard<mutex> lock(shared);
+    return chromosome.value;
+}
+
+// Counts the evaluations of this process, the workers count in their own copies.
+int parentEvaluations = 0;
+
+double countingFitnessFunction(Chromosome &chromosome)
+{
+    ++parentEvaluations;
+    int ones = 0;
+    for (int i = 0; i < 8; i++)
+        ones += __builtin_popcount(((uint8_t *)&chromosome)[i]);
+    return min(ones, 40); // a plateau, so the run restarts
+}
+
+int main()
+{
+#if EVALUATOR_POOL_PROCESSES
+    const double penalty = -1;
+    EvaluatorPool pool(3, sizeof(Chromosome), [](uint8_t *chromosome) -> double
+                       { return fitnessFunction(*(Chromosome *)chromosome); },
+                       100, penalty, 8);
+
+    vector<Chromosome> chromosomes(100);
+    for (int i = 0; i < 100; i++)
+        chromosomes[i].value = (uint8_t)i;
+    vector<double> fitness(100);
+    if (!pool.evaluate((uint8_t *)chromosomes.data(), 100, fitness.data()))
+        return 1;
+
+    for (int i = 0; i < 100; i++)
+        if (fitness[i] != ((i == 13 || i == 42) ? penalty : i))
+            return 1;
+    if (pool.getCrashesCount() != 1 || pool.getTimeoutsCount() != 1 || pool.getInProcessCount() != 0 || pool.getLostCount() != 0)
+        return 1;
+    // The writes to the dead workers did not need the SIGPIPE handling of the process to change.
+    struct sigaction action;
+    if (sigaction(SIGPIPE, nullptr, &action) != 0 || action.sa_handler != SIG_DFL)
+        return 1;
+
+    // The same pool keeps working after respawning the workers.
+    pool.evaluate((uint8_t *)&chromosomes[50], 2, fitness.data());
+    if (fitness[0] != 50 || fitness[1] != 51)
+        return 1;
+
+    // The workers are respawned while another thread holds a lock: they are forked by the zygote, which copied the process
+    // before that thread started, so they never inherit the held lock.
+    {
+        EvaluatorPool lockingPool(2, sizeof(Chromosome), [](uint8_t *chromosome) -> double
+                                  { return lockingFitnessFunction(*(Chromosome *)chromosome); },
+                                  1000, penalty, 4);
+        mutex stateMutex;
+        condition_variable stateCondition;
+        bool locked = false, done = false;
+        thread holder([&]
+                      {
+                          lock_guard<mutex> held(shared);
+                          unique_lock<mutex> lock(stateMutex);
+                          locked = true;
+                          stateCondition.notify_all();
+                          stateCondition.wait(lock, [&] { return done; }); });
+        {
+            unique_lock<mutex> lock(stateMutex);
+            stateCondition.wait(lock, [&] { return locked; });
+        }
+        bool evaluated = lockingPool.evaluate((uint8_t *)chromosomes.data(), 40, fitness.data());
+        {
+            lock_guard<mutex> lock(stateMutex);
+            done = true;
+            stateCondition.notify_all();
+        }
+        holder.join();
+        if (!evaluated || lockingPool.getCrashesCount() != 1 || lockingPool.getTimeoutsCount() != 0)
+            return 1;
+        for (int i = 0; i < 40; i++)
+            if (fitness[i] != (i == 13 ? penalty : i))
+                return 1;
+    }
+
+    // The bad chromosomes are rejected by the genetic algorithm.
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 30);
+    ga.setEvaluatorPool(2, 100);
+    ga.initializePopulation(50);
+    auto bestIndividual = ga.solve();
+    if (bestIndividual.isRejected() || bestIndividual.getFitness() != bestIndividual.getChromosome().value)
+        return 1;
+
+    // Every evaluation of the solver goes through the pool: restarts, kick out, duplicate elimination and the local search.
+    GeneticAlgorithm<Chromosome> routed(countingFitnessFunction, true, 60);
+    routed.setVerbose(false);
+    routed.setEvaluatorPool(2);
+    routed.setRestartStrategy(5, 1.5, 1);
+    routed.setKickOutAge(3);
+    routed.setDuplicateElimination(true);
+    routed.setLocalSearch(LocalSearch::BitFlip, 2, 10);
+    routed.initializePopulation(40);
+    bestIndividual = routed.solve();
+    if (parentEvaluations != 0 || routed.getRestartsCount() != 1 || bestIndividual.getFitness() != 40)
+        return 1;
+#endif
+    return 0;
+}
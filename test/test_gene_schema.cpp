@@ -0,0 +1,101 @@
+/**
+ * @file test_gene_schema.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the typed gene schema
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+enum Color
+{
+    Red,
+    Green,
+    Blue
+};
+
+typedef GeneSchema<IntGene<-20, 25>, FixedGene<-5, 5, 2, true>, EnumGene<Color, 3>, BoolGene, IntGene<0, 1000, true>> Schema;
+
+static_assert(Schema::bits() == 6 + 10 + 2 + 1 + 10, "bits");
+static_assert(Schema::offset<3>() == 18, "offset");
+static_assert(sizeof(Schema::Chromosome) == 4, "size");
+
+double fitness(int64_t a, double x, Color color, bool flag, int64_t b)
+{
+    return -fabs(a - 7.0) - fabs(x - 1.25) + (color == Blue) + flag - fabs(b - 600.0) / 100;
+}
+
+int popcount(uint64_t x)
+{
+    int n = 0;
+    for (; x; x &= x - 1)
+        ++n;
+    return n;
+}
+
+int main()
+{
+    // Every value survives encode / decode, the other genes are left untouched.
+    Schema::Chromosome chromosome;
+    memset(&chromosome, 0xA5, sizeof(chromosome));
+    Schema::set<2>(chromosome, Green);
+    Schema::set<3>(chromosome, true);
+    for (int64_t a = -20; a <= 25; a++)
+    {
+        Schema::set<0>(chromosome, a);
+        if (Schema::get<0>(chromosome) != a)
+            return 1;
+    }
+    for (int k = -500; k <= 500; k++)
+    {
+        Schema::set<1>(chromosome, k / 100.0);
+        if (fabs(Schema::get<1>(chromosome) - k / 100.0) > 1e-9)
+            return 1;
+    }
+    for (int64_t b = 0; b <= 1000; b++)
+    {
+        Schema::set<4>(chromosome, b);
+        if (Schema::get<4>(chromosome) != b)
+            return 1;
+    }
+    if (Schema::get<0>(chromosome) != 25 || Schema::get<2>(chromosome) != Green || !Schema::get<3>(chromosome))
+        return 1;
+
+    // Every code decodes into the range, and with Gray coding the neighbour values are one bit apart.
+    for (uint64_t code = 0; code < 1024; code++)
+    {
+        int64_t b = IntGene<0, 1000, true>::decode(code);
+        if (b < 0 || b > 1000)
+            return 1;
+    }
+    for (int64_t b = 1; b <= 1000; b++)
+    {
+        uint64_t code = IntGene<0, 1000, true>::encode(b); // the code before it is the last one of b - 1
+        if (IntGene<0, 1000, true>::decode(code - 1) != b - 1 || popcount(binaryToGray(code) ^ binaryToGray(code - 1)) != 1)
+            return 1;
+    }
+
+    tuple<int64_t, double, Color, bool, int64_t> values = Schema::decode(chromosome);
+    if (get<0>(values) != 25 || get<4>(values) != 1000)
+        return 1;
+
+    vector<Schema::Chromosome> column(3, chromosome);
+    int64_t decoded[3];
+    Schema::decodeColumn<4>(column.data(), 3, decoded);
+    if (decoded[2] != 1000)
+        return 1;
+
+    GeneticAlgorithm<Schema::Chromosome> ga(Schema::fitness(fitness), true, 200, 2, 15, Selection::MixSelection, Crossover::MixCrossover);
+    ga.setVerbose(false);
+    ga.setSeed(1);
+    ga.initializePopulation(200);
+    Individual<Schema::Chromosome> best = ga.solve();
+    if (best.getFitness() < 1.5)
+        return 1;
+    return 0;
+}
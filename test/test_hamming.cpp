@@ -0,0 +1,151 @@
+/**
+ * @file test_hamming.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the Hamming nearest neighbour index and the surrogate screening built on it
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+#include <random>
+
+using namespace std;
+
+const int size = 32; // bytes
+
+struct Chromosome
+{
+    uint8_t genes[size];
+};
+
+int distance(const Chromosome &a, const Chromosome &b)
+{
+    int d = 0;
+    for (int i = 0; i < size; i++)
+        d += popcount64(a.genes[i] ^ b.genes[i]);
+    return d;
+}
+
+// A cluster member: the center with %flips% random bits flipped
+Chromosome member(const Chromosome &center, int flips, mt19937 &random)
+{
+    Chromosome c = center;
+    for (int f = 0; f < flips; f++)
+    {
+        int bit = random() % (size * 8);
+        c.genes[bit >> 3] ^= (uint8_t)(1 << (bit & 7));
+    }
+    return c;
+}
+
+bool testNearest()
+{
+    // 40 clusters of 100 chromosomes, like a population around a few optima. The members are too far apart to share
+    // many buckets, the buckets one or two bits away hold the rest of the cluster.
+    mt19937 random(3);
+    vector<Chromosome> centers(40), chromosomes;
+    for (auto &center : centers)
+        for (int i = 0; i < size; i++)
+            center.genes[i] = (uint8_t)random();
+    HammingIndex index(size);
+    for (auto &center : centers)
+        for (int m = 0; m < 100; m++)
+        {
+            chromosomes.push_back(member(center, 24, random));
+            if (index.insert(chromosomes.back().genes) != (int)chromosomes.size() - 1)
+                return false;
+        }
+
+    const int k = 10;
+    vector<pair<int, int>> neighbours;
+    for (int q = 0; q < 100; q++)
+    {
+        Chromosome query = member(centers[q % 40], 24, random);
+        index.nearest(query.genes, k, neighbours);
+        if ((int)neighbours.size() != k)
+            return false;
+        for (int i = 0; i < k; i++)
+        {
+            // The right distances, sorted, all in the cluster of the query (the other clusters are ~128 bits away)
+            if (neighbours[i].first != distance(query, chromosomes[neighbours[i].second]) || neighbours[i].first > 80)
+                return false;
+            if (i > 0 && neighbours[i].first < neighbours[i - 1].first)
+                return false;
+        }
+    }
+    // The probes find the neighbours, the index is almost never scanned.
+    if (index.getLinearScansCount() > 5)
+        return false;
+
+    // An exact copy is the nearest one, at distance 0.
+    index.nearest(chromosomes[1234].genes, 1, neighbours);
+    if (neighbours.size() != 1 || neighbours[0].first != 0 || neighbours[0].second != 1234)
+        return false;
+
+    // k larger than the index: every chromosome, by a linear scan.
+    HammingIndex small(size);
+    for (int i = 0; i < 20; i++)
+        small.insert(chromosomes[i].genes);
+    small.nearest(chromosomes[0].genes, 50, neighbours);
+    if (neighbours.size() != 20 || small.getLinearScansCount() != 1)
+        return false;
+
+    // within() returns the bucket neighbours inside the radius.
+    index.within(chromosomes[7].genes, 80, neighbours);
+    if (neighbours.empty() || neighbours[0].second != 7)
+        return false;
+    for (auto &neighbour : neighbours)
+        if (neighbour.first > 80 || neighbour.first != distance(chromosomes[7], chromosomes[neighbour.second]))
+            return false;
+    return true;
+}
+
+int evaluations = 0;
+
+double oneMax(Chromosome &chromosome)
+{
+    ++evaluations;
+    int ones = 0;
+    for (int i = 0; i < size; i++)
+        ones += popcount64(chromosome.genes[i]);
+    return ones;
+}
+
+// Best fitness after a fixed number of generations, and the evaluations it took
+double run(bool screening, uint32_t seed, int &used)
+{
+    GeneticAlgorithm<Chromosome> ga(oneMax, true, 30);
+    ga.setVerbose(false);
+    ga.setSeed(seed);
+    if (screening)
+        ga.setSurrogateScreening(4);
+    ga.initializePopulation(100);
+    evaluations = 0;
+    double best = ga.solve().getFitness();
+    used = evaluations;
+    return best;
+}
+
+bool testScreening()
+{
+    // The k-nearest-neighbour surrogate ranks 4 candidates per slot: the same number of evaluations, better offspring.
+    double screened = 0, plain = 0;
+    for (uint32_t seed = 1; seed <= 3; seed++)
+    {
+        int screenedEvaluations, plainEvaluations;
+        screened += run(true, seed, screenedEvaluations);
+        plain += run(false, seed, plainEvaluations);
+        if (screenedEvaluations != plainEvaluations)
+            return false;
+    }
+    return screened > plain;
+}
+
+int main()
+{
+    if (!testNearest() || !testScreening())
+        return 1;
+    return 0;
+}
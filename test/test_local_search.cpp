@@ -0,0 +1,253 @@
+/**
+ * @file test_local_search.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the memetic local search (bit flips, 2-opt, user function) and the parallel loops of the thread pool, nested too
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+#include <atomic>
+
+using namespace std;
+
+struct Bits
+{
+    uint8_t genes[12];
+};
+
+struct Tour
+{
+    uint8_t city[12];
+};
+
+atomic<int> evaluations(0);
+shared_ptr<ThreadPool> sharedPool;
+
+double oneMax(Bits &chromosome)
+{
+    ++evaluations;
+    double scoure = 0;
+    for (int i = 0; i < 12; i++)
+        scoure += __builtin_popcount(chromosome.genes[i]);
+    return scoure;
+}
+
+// Cities in place, to maximize
+double inPlace(Tour &tour)
+{
+    double scoure = 0;
+    for (int i = 0; i < 12; i++)
+        scoure += (tour.city[i] == i);
+    return scoure;
+}
+
+bool isPermutation(Tour &tour)
+{
+    bool seen[12] = {};
+    for (int i = 0; i < 12; i++)
+    {
+        if (tour.city[i] >= 12 || seen[tour.city[i]])
+            return false;
+        seen[tour.city[i]] = true;
+    }
+    return true;
+}
+
+void fixTour(Tour &tour)
+{
+    bool seen[12] = {};
+    for (int i = 0; i < 12; i++)
+    {
+        tour.city[i] %= 12;
+        if (seen[tour.city[i]])
+            tour.city[i] = 255;
+        else
+            seen[tour.city[i]] = true;
+    }
+    for (int i = 0, c = 0; i < 12; i++)
+        if (tour.city[i] == 255)
+        {
+            while (seen[c])
+                ++c;
+            tour.city[i] = (uint8_t)c;
+            seen[c] = true;
+        }
+}
+
+bool testParallelFor()
+{
+    for (int threads : {1, 2, 4})
+    {
+        ThreadPool pool(threads);
+        vector<atomic<int>> hits(1000);
+        for (auto &h : hits)
+            h = 0;
+        pool.parallelFor(10, 1000, [&hits](int i)
+                         { ++hits[i]; });
+        for (int i = 0; i < 1000; i++)
+            if (hits[i] != (i >= 10))
+                return false;
+
+        int calls = 0;
+        pool.parallelFor(5, 5, [&calls](int)
+                         { ++calls; });
+        pool.parallelFor(7, 8, [&calls](int i)
+                         { calls += i; });
+        if (calls != 7)
+            return false;
+
+        // Nested loops on the same pool: the threads inside a task keep taking the inner indices, nothing waits forever.
+        for (auto &h : hits)
+            h = 0;
+        pool.parallelFor(0, 10, [&pool, &hits](int i)
+                         { pool.parallelFor(0, 10, [&pool, &hits, i](int j)
+                                            { pool.parallelFor(0, 10, [&hits, i, j](int k)
+                                                               { ++hits[100 * i + 10 * j + k]; }); }); });
+        for (int i = 0; i < 1000; i++)
+            if (hits[i] != 1)
+                return false;
+
+        // The submitted tasks run on the pool threads, there are none with one thread.
+        if (threads == 1)
+            continue;
+        atomic<int> submitted(0);
+        for (int i = 0; i < 20; i++)
+            pool.submit([&submitted]()
+                        { ++submitted; });
+        for (int wait = 0; submitted != 20 && wait < 5000; wait++)
+            this_thread::sleep_for(chrono::milliseconds(1));
+        if (submitted != 20)
+            return false;
+    }
+    return true;
+}
+
+// One first-improvement pass over the 96 bits reaches the optimum of OneMax
+bool testBitFlip(int threads, bool lamarckian, double &best)
+{
+    GeneticAlgorithm<Bits> ga(oneMax, true, 1);
+    ga.setVerbose(false);
+    ga.setSeed(7);
+    ga.setThreadsCount(threads);
+    ga.setLocalSearch(LocalSearch::BitFlip, 5, 96, lamarckian);
+    ga.initializePopulation(30);
+    const uint64_t initial = ga.getEvaluationsCount();
+    Individual<Bits> result = ga.solve();
+    best = result.getFitness();
+
+    // Two generations improve 5 new individuals each, within the budget, and one breeds at most 30 offspring.
+    if (ga.getEvaluationsCount() - initial > 2 * 5 * 96 + 30)
+        return false;
+    // The improved chromosome is the best so far in both modes.
+    Bits chromosome;
+    double fitness;
+    if (!ga.getBestSoFar(chromosome, fitness) || fitness != 96 || oneMax(chromosome) != 96)
+        return false;
+
+    // Every individual holds the fitness of its own chromosome, the returned one too.
+    Bits resultChromosome = result.getChromosome();
+    if (best != oneMax(resultChromosome))
+        return false;
+    int improved = 0;
+    for (auto &individual : ga.getPopulation())
+    {
+        chromosome = individual.getChromosome();
+        if (individual.getFitness() != oneMax(chromosome) || (!lamarckian && individual.getFitness() > best))
+            return false;
+        improved += (individual.getLearnedFitness() == 96);
+    }
+    // Baldwinian: the improved fitness only ranks the individuals
+    return improved >= 5 && (lamarckian ? best == 96 : best < 96);
+}
+
+bool testTwoOpt(int threads, vector<Individual<Tour>> &population)
+{
+    GeneticAlgorithm<Tour> ga(inPlace, true, 30, 2, 20);
+    ga.setVerbose(false);
+    ga.setSeed(8);
+    ga.setThreadsCount(threads);
+    ga.setChromosomeFixFunction(fixTour);
+    ga.setLocalSearch(LocalSearch::TwoOpt, 4, 200);
+    ga.initializePopulation(40);
+    double initialBest = 0;
+    for (auto &individual : ga.getPopulation())
+        initialBest = max(initialBest, individual.getFitness());
+
+    if (ga.solve().getFitness() <= initialBest)
+        return false;
+    population = ga.getPopulation();
+    for (auto &individual : population)
+    {
+        Tour tour = individual.getChromosome();
+        if (!isPermutation(tour) || individual.getFitness() != inPlace(tour))
+            return false;
+    }
+    return true;
+}
+
+// A user hill climber scoring its neighbours with its own loop on the pool of the solver
+double climb(Bits &chromosome, double fitness, int evaluationsBudget)
+{
+    for (int round = 0; round * 96 < evaluationsBudget; round++)
+    {
+        vector<double> neighbours(96);
+        sharedPool->parallelFor(0, 96, [&chromosome, &neighbours](int bit)
+                                {
+                                    Bits candidate = chromosome;
+                                    FLIP_BIT(candidate.genes[bit >> 3], bit & 7);
+                                    neighbours[bit] = oneMax(candidate); });
+        int best = (int)(max_element(neighbours.begin(), neighbours.end()) - neighbours.begin());
+        if (neighbours[best] <= fitness)
+            break;
+        FLIP_BIT(chromosome.genes[best >> 3], best & 7);
+        fitness = neighbours[best];
+    }
+    return fitness;
+}
+
+bool testLocalSearchFunction()
+{
+    sharedPool = make_shared<ThreadPool>(4);
+    GeneticAlgorithm<Bits> ga(oneMax, true, 3);
+    ga.setVerbose(false);
+    ga.setSeed(9);
+    ga.setThreadPool(sharedPool);
+    ga.setLocalSearchFunction(climb, 6, 96 * 8);
+    ga.initializePopulation(30);
+    Individual<Bits> best = ga.solve();
+    Bits chromosome = best.getChromosome();
+    sharedPool.reset();
+    return best.getFitness() >= 90 && best.getFitness() == oneMax(chromosome);
+}
+
+bool samePopulation(vector<Individual<Tour>> &a, vector<Individual<Tour>> &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++)
+        if (a[i].getFitness() != b[i].getFitness() || memcmp(a[i].getChromosomePointer(), b[i].getChromosomePointer(), sizeof(Tour)) != 0)
+            return false;
+    return true;
+}
+
+int main()
+{
+    if (!testParallelFor())
+        return 1;
+
+    double serialBest, parallelBest;
+    if (!testBitFlip(1, true, serialBest) || !testBitFlip(4, true, parallelBest) || !testBitFlip(4, false, parallelBest))
+        return 1;
+
+    // Each individual is improved from its own seed, so the threads count does not change the run.
+    vector<Individual<Tour>> serial, parallel;
+    if (!testTwoOpt(1, serial) || !testTwoOpt(4, parallel) || !samePopulation(serial, parallel))
+        return 1;
+
+    if (!testLocalSearchFunction())
+        return 1;
+    return 0;
+}
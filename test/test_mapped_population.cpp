@@ -0,0 +1,61 @@
+/**
+ * @file test_mapped_population.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test that a mapped (out-of-core) population gives the same run as the in-memory one
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+#include <stdio.h>
+
+using namespace std;
+
+struct Chromosome
+{
+    uint8_t genes[24];
+};
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    double scoure = 0;
+    for (int i = 0; i < 24; i++)
+        scoure += (chromosome.genes[i] % 13) * (i % 4 + 1);
+    return scoure;
+}
+
+const char *path = "test_mapped_population.bin";
+
+// The same seeded run in memory and in a mapped file, with %chunkSize% offspring per chunk
+bool sameRun(Selection selection, Crossover crossover, int chunkSize, int threadsCount)
+{
+    GeneticAlgorithm<Chromosome> inMemory(fitnessFunction, true, 60, 1.5, 15, selection, crossover);
+    inMemory.setVerbose(false);
+    inMemory.setSeed(9);
+    inMemory.initializePopulation(200);
+    Individual<Chromosome> expected = inMemory.solve();
+
+    GeneticAlgorithm<Chromosome> mapped(fitnessFunction, true, 60, 1.5, 15, selection, crossover);
+    mapped.setVerbose(false);
+    mapped.setSeed(9);
+    if (threadsCount > 1)
+        mapped.setThreadsCount(threadsCount);
+    mapped.initializeMappedPopulation(200, path, chunkSize);
+    if (!mapped.isMappedPopulation())
+        return false;
+    Individual<Chromosome> best = mapped.solve();
+
+    return best.getFitness() == expected.getFitness() && mapped.getGeneration() == inMemory.getGeneration() && mapped.isTerminated() &&
+           memcmp(best.getChromosomePointer(), expected.getChromosomePointer(), sizeof(Chromosome)) == 0;
+}
+
+int main()
+{
+    bool passed = sameRun(Selection::Fast, Crossover::Uniform, 4096, 1) &&
+                  sameRun(Selection::RouletteWheel, Crossover::TwoPoint, 64, 1) &&
+                  sameRun(Selection::MixSelection, Crossover::MixCrossover, 7, 2); // chunks smaller than a page, several threads
+    remove(path);
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file test_multi_objective.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test non-dominated sorting and the multi-objective mode
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+bool dominates(const vector<double> &a, const vector<double> &b)
+{
+    bool better = false;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a[i] > b[i])
+            return false;
+        if (a[i] < b[i])
+            better = true;
+    }
+    return better;
+}
+
+// O(m n^3) reference: peel the non-dominated points front by front
+vector<int> naiveSort(const vector<vector<double>> &objectives)
+{
+    int n = objectives.size();
+    vector<int> rank(n, -1);
+    for (int front = 0, assigned = 0; assigned < n; front++)
+    {
+        vector<int> current;
+        for (int i = 0; i < n; i++)
+        {
+            if (rank[i] != -1)
+                continue;
+            bool dominated = false;
+            for (int j = 0; j < n && !dominated; j++)
+                dominated = (rank[j] == -1 && dominates(objectives[j], objectives[i]));
+            if (!dominated)
+                current.push_back(i);
+        }
+        for (int i : current)
+            rank[i] = front;
+        assigned += current.size();
+    }
+    return rank;
+}
+
+struct Chromosome
+{
+    byte x, y;
+};
+
+// Schaffer-like problem: the Pareto front is x in [0, 2]
+vector<double> objectivesFunction(Chromosome &chromosome)
+{
+    double x = chromosome.x / 32.0;
+    return {x * x, (x - 2) * (x - 2)};
+}
+
+int main()
+{
+    for (int m = 1; m <= 5; m++)
+        for (int test = 0; test < 20; test++)
+        {
+            int n = 1 + rand() % 200;
+            vector<vector<double>> objectives(n, vector<double>(m));
+            for (auto &point : objectives)
+                for (auto &value : point)
+                    value = rand() % 10; // many ties and duplicates
+
+            vector<int> rank;
+            int fronts = nonDominatedSort(objectives, rank);
+            vector<int> expected = naiveSort(objectives);
+            if (rank != expected || fronts != *max_element(expected.begin(), expected.end()) + 1)
+                return 1;
+        }
+
+    GeneticAlgorithm<Chromosome> ga(objectivesFunction, {false, false}, 60, 2);
+    ga.initializePopulation(100);
+    ga.solve();
+
+    vector<Individual<Chromosome>> front = ga.getParetoFront();
+    if (front.size() < 10)
+        return 1;
+    for (auto &a : front)
+    {
+        if (a.getChromosome().x > 64)
+            return 1;
+        for (auto &b : front)
+            if (dominates(a.getObjectives(), b.getObjectives()))
+                return 1;
+    }
+
+    return 0;
+}
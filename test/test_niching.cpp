@@ -0,0 +1,82 @@
+/**
+ * @file test_niching.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the niching (clearing and fitness sharing) on a problem with several peaks
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+// Four peaks of the same height, at least 8 bits apart
+const uint16_t peaks[] = {0x0000, 0xFF00, 0x00FF, 0xFFFF};
+
+int distance(uint16_t a, uint16_t b)
+{
+    int d = 0;
+    for (unsigned x = a ^ b; x; x &= x - 1)
+        ++d;
+    return d;
+}
+
+double fitnessFunction(uint16_t &chromosome)
+{
+    int nearest = 16;
+    for (uint16_t peak : peaks)
+        nearest = min(nearest, distance(chromosome, peak));
+    return pow(2.0, 8 - nearest); // sharp peaks, a crowded peak still beats the valleys
+}
+
+// Number of peaks reached by the niches
+int peaksFound(vector<Individual<uint16_t>> niches, int tolerance)
+{
+    int found = 0;
+    for (uint16_t peak : peaks)
+    {
+        bool reached = false;
+        for (auto &niche : niches)
+            reached = reached || distance(niche.getChromosome(), peak) <= tolerance;
+        found += reached;
+    }
+    return found;
+}
+
+int main()
+{
+    HammingIndex index(4, 8, 4);
+    uint32_t a = 0, b = 3, c = 0xFF00;
+    index.insert((uint8_t *)&a);
+    index.insert((uint8_t *)&b);
+    index.insert((uint8_t *)&c);
+    vector<pair<int, int>> neighbours;
+    index.within((uint8_t *)&a, 2, neighbours);
+    for (auto &neighbour : neighbours)
+        if (neighbour.first > 2 || neighbour.second == 2)
+            return 1;
+
+    Niching methods[] = {Niching::Clearing, Niching::FitnessSharing};
+    for (Niching method : methods)
+    {
+        GeneticAlgorithm<uint16_t> ga(fitnessFunction, true, 150, 2, 10, Selection::Fast, Crossover::Uniform);
+        ga.setVerbose(false);
+        ga.setSeed(9);
+        ga.setNiching(method, 4);
+        ga.initializePopulation(200);
+        Individual<uint16_t> best = ga.solve();
+        if (best.getFitness() != 256)
+            return 1;
+
+        vector<Individual<uint16_t>> niches = ga.getNiches();
+        for (size_t i = 0; i < niches.size(); i++)
+            for (size_t j = 0; j < i; j++)
+                if (distance(niches[i].getChromosome(), niches[j].getChromosome()) < 4)
+                    return 1;
+        if (peaksFound(niches, 2) < 3)
+            return 1;
+    }
+    return 0;
+}
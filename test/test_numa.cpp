@@ -0,0 +1,52 @@
+/**
+ * @file test_numa.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the NUMA topology and the pinned thread pool
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+double fitnessFunction(uint32_t &chromosome)
+{
+    double x = chromosome % 1000;
+    return -(x - 321) * (x - 321);
+}
+
+int main()
+{
+    vector<int> cpus = NumaTopology::parseCpuList("0-3,8,10-11\n");
+    int expected[] = {0, 1, 2, 3, 8, 10, 11};
+    if (cpus != vector<int>(expected, expected + 7))
+        return 1;
+
+    // At least one node, every thread gets a usable CPU, consecutive threads on the same node.
+    NumaTopology topology;
+    if (topology.nodesCount() < 1 || topology.getCpus(0).empty())
+        return 1;
+    vector<int> placement = topology.place(8);
+    for (size_t t = 0; t < placement.size(); t++)
+        if (topology.getNode(placement[t]) < 0 || (t > 0 && topology.getNode(placement[t]) < topology.getNode(placement[t - 1])))
+            return 1;
+
+    // The pinned pool works like the other one and reports its placement.
+    GeneticAlgorithm<uint32_t> ga(fitnessFunction, true, 100, 2, 15);
+    ga.setVerbose(false);
+    ga.setSeed(4);
+    ga.setThreadsCount(4, true);
+    if (ga.getThreadPlacement().find("thread 3") == string::npos)
+        return 1;
+    ga.initializePopulation(100);
+    if (ga.solve().getFitness() != 0)
+        return 1;
+
+    ga.setThreadsCount(4);
+    if (!ga.getThreadPlacement().empty())
+        return 1;
+    return 0;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file test_operator_selector.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test that the adaptive operator selection converges to the better operator
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "OperatorSelector.h"
+#include <random>
+#include <math.h>
+
+using namespace std;
+
+// Operator 1 improves its offspring 3 times as often as operator 0. Each generation selects a batch of operators,
+// then credits them, like the batch and pipelined evaluation.
+bool converges(Adaptation adaptation)
+{
+    OperatorSelector selector;
+    selector.reset({70, 30}, adaptation); // the fixed mix starts against the better operator
+    mt19937 random(5);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    const int batch = 50;
+    uint64_t firstBatch[2] = {0, 0};
+    for (int generation = 0; generation < 200; generation++)
+    {
+        vector<int> selected(batch);
+        for (int i = 0; i < batch; i++)
+            selected[i] = selector.select(uniform(random));
+        if (generation == 0)
+            for (int index : selected)
+                ++firstBatch[index];
+        for (int index : selected)
+            selector.credit(index, uniform(random) < (index == 1 ? 0.6 : 0.2) ? 1.0 : 0.0);
+    }
+
+    vector<OperatorStats> &stats = selector.getStats();
+    // Both operators are tried within the first batch, before any credit.
+    if (firstBatch[0] == 0 || firstBatch[1] == 0)
+        return false;
+    if (stats[0].uses + stats[1].uses != 200 * batch || stats[0].credits != stats[0].uses || stats[1].credits != stats[1].uses)
+        return false;
+    // The better operator gets most of the selections and the higher quality, the other one is still explored.
+    if (stats[1].quality <= stats[0].quality || stats[1].probability <= 0.6 || stats[0].uses == 0)
+        return false;
+    if (adaptation == MultiArmedBandit && (fabs(stats[1].quality - 0.6) > 0.05 || stats[1].probability <= 0.9))
+        return false; // the mean reward, and UCB1 pulls the better arm almost always
+    return true;
+}
+
+int main()
+{
+    if (!converges(MultiArmedBandit) || !converges(ProbabilityMatching))
+        return 1;
+    return 0;
+}
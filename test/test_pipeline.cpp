@@ -0,0 +1,106 @@
+/**
+ * @file test_pipeline.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test that the pipelined evaluation gives the same population as the serial one, and stops cleanly when cancelled
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+#include <atomic>
+
+using namespace std;
+
+struct Chromosome
+{
+    uint8_t genes[32];
+};
+
+atomic<int> evaluations(0), cancelAfter(-1);
+shared_ptr<CancellationToken> token;
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    if (++evaluations == cancelAfter) // in the middle of a generation
+        token->cancel();
+    double scoure = 0;
+    for (int i = 0; i < 32; i++)
+        scoure += (chromosome.genes[i] % 11) * (i % 3 + 1);
+    return scoure;
+}
+
+vector<Individual<Chromosome>> run(bool pipelined, int chunkSize)
+{
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 50, 2, 15, Selection::MixSelection, Crossover::MixCrossover);
+    ga.setVerbose(false);
+    ga.setSeed(21);
+    ga.setThreadsCount(4);
+    ga.setPipelinedEvaluation(pipelined, chunkSize, 4);
+    ga.initializePopulation(300);
+    ga.solve();
+    return ga.getPopulation();
+}
+
+bool samePopulation(vector<Individual<Chromosome>> a, vector<Individual<Chromosome>> b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++)
+        if (a[i].getFitness() != b[i].getFitness() || a[i].getAge() != b[i].getAge() ||
+            memcmp(a[i].getChromosomePointer(), b[i].getChromosomePointer(), sizeof(Chromosome)) != 0)
+            return false;
+    return true;
+}
+
+bool cancelMidPipeline()
+{
+    shared_ptr<ThreadPool> pool = make_shared<ThreadPool>(4);
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 50, 2, 15);
+    ga.setVerbose(false);
+    ga.setSeed(21);
+    ga.setThreadPool(pool);
+    ga.setPipelinedEvaluation(true, 8, 2);
+    token = make_shared<CancellationToken>();
+    ga.setCancellationToken(token);
+    ga.initializePopulation(300);
+
+    evaluations = 0;
+    cancelAfter = 1000; // chunks are still queued
+    ga.solve();
+    // Each thread stops before its next evaluation.
+    if (evaluations - cancelAfter >= pool->size())
+        return false;
+    cancelAfter = -1;
+
+    // The population is the last complete generation, every fitness matches its chromosome.
+    vector<Individual<Chromosome>> population = ga.getPopulation();
+    if (population.size() != 300)
+        return false;
+    for (auto &individual : population)
+        if (individual.getFitness() != fitnessFunction(*(Chromosome *)individual.getChromosomePointer()))
+            return false;
+
+    // The helpers left the pool: all its threads take new tasks.
+    atomic<int> done(0);
+    pool->parallelFor(0, 64, [&done](int)
+                      { ++done; });
+    if (done != 64)
+        return false;
+
+    // The same solver runs again to the end.
+    token->reset();
+    ga.solve();
+    return ga.getGeneration() == 50;
+}
+
+int main()
+{
+    vector<Individual<Chromosome>> serial = run(false, 16);
+    if (!samePopulation(serial, run(true, 16)) || !samePopulation(serial, run(true, 1)) || !samePopulation(serial, run(true, 1000)))
+        return 1;
+    if (!cancelMidPipeline())
+        return 1;
+    return 0;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file test_population_statistics.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the incremental population statistics and the convergence termination conditions
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+struct Chromosome
+{
+    uint8_t genes[12];
+};
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    double scoure = 0;
+    for (int i = 0; i < 12; i++)
+        scoure += (chromosome.genes[i] % 11) * (i % 4 + 1);
+    return scoure;
+}
+
+double flatFitnessFunction(Chromosome &chromosome)
+{
+    (void)chromosome;
+    return 5;
+}
+
+// Compare the incremental statistics with a new count of the population
+bool matches(GeneticAlgorithm<Chromosome> &ga)
+{
+    vector<Individual<Chromosome>> population = ga.getPopulation();
+    PopulationStatistics expected(sizeof(Chromosome));
+    for (auto &individual : population)
+        expected.add(individual.getChromosomePointer(), individual.getFitness());
+
+    PopulationStatistics &statistics = ga.getPopulationStatistics();
+    if (statistics.size() != expected.size())
+        return false;
+    if (fabs(statistics.getMean() - expected.getMean()) > 1e-9 * (1 + fabs(expected.getMean())) ||
+        fabs(statistics.getStandardDeviation() - expected.getStandardDeviation()) > 1e-6 * (1 + expected.getStandardDeviation()))
+        return false;
+    for (int bit = 0; bit < (int)sizeof(Chromosome) * 8; bit++)
+        if (statistics.getAlleleFrequency(bit) != expected.getAlleleFrequency(bit))
+            return false;
+    return true;
+}
+
+bool run(int threadsCount, bool pipelined, bool extras)
+{
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 60, 3, 20, Selection::MixSelection, Crossover::MixCrossover);
+    ga.setVerbose(false);
+    ga.setThreadsCount(threadsCount);
+    ga.setPipelinedEvaluation(pipelined, 8);
+    ga.setPopulationStatistics(true);
+    if (extras)
+    {
+        ga.setKickOutAge(3);
+        ga.setDuplicateElimination(true);
+        ga.setLocalSearch(LocalSearch::BitFlip, 3, 40);
+        ga.setRestartStrategy(10, 1.0);
+    }
+    ga.initializePopulation(50);
+    while (!ga.isTerminated())
+    {
+        ga.step(7);
+        if (!matches(ga))
+            return false;
+    }
+    return true;
+}
+
+int main()
+{
+    if (!run(1, false, false) || !run(1, false, true) || !run(4, true, false) || !run(4, true, true))
+        return 1;
+
+    // A flat fitness is inside any band at once.
+    GeneticAlgorithm<Chromosome> flat(flatFitnessFunction, true, 100);
+    flat.setVerbose(false);
+    flat.terminationConditions.setFitnessBand(0.01);
+    flat.initializePopulation(30);
+    flat.step(100);
+    if (!flat.isTerminated() || flat.getGeneration() != 0)
+        return 1;
+
+    // The best fitness stops improving long before the max generation.
+    GeneticAlgorithm<Chromosome> sloped(fitnessFunction, true, 100000);
+    sloped.setVerbose(false);
+    sloped.terminationConditions.setMinImprovementSlope(0.01, 30);
+    sloped.initializePopulation(40);
+    sloped.solve();
+    if (sloped.getGeneration() < 30 || sloped.getGeneration() >= 100000)
+        return 1;
+    return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file test_repair.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the repair helpers and the batch repair function
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+const int sz = 20;
+
+struct Chromosome
+{
+    uint8_t city[sz];
+};
+
+bool isPermutation(const uint8_t *genes, int count)
+{
+    vector<bool> seen(count, false);
+    for (int i = 0; i < count; i++)
+    {
+        if (genes[i] >= count || seen[genes[i]])
+            return false;
+        seen[genes[i]] = true;
+    }
+    return true;
+}
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    double length = 0;
+    for (int i = 0; i < sz; i++)
+        length += abs(chromosome.city[i] - chromosome.city[(i + 1) % sz]);
+    return length;
+}
+
+atomic<int> repairCalls(0);
+
+void repairTours(Chromosome *chromosomes, int count, ScratchArena &arena)
+{
+    ++repairCalls;
+    for (int i = 0; i < count; i++)
+        repairPermutation(chromosomes[i].city, sz, arena);
+}
+
+Individual<Chromosome> run(int threads, bool &valid)
+{
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, false, 30, 4, 15, Selection::MixSelection, Crossover::MixCrossover);
+    ga.setVerbose(false);
+    ga.setSeed(11);
+    ga.setThreadsCount(threads);
+    ga.setBatchRepairFunction(repairTours, 16);
+    ga.initializePopulation(100);
+    Individual<Chromosome> best = ga.solve();
+
+    valid = true;
+    for (auto &individual : ga.getPopulation())
+        valid = valid && isPermutation(individual.getChromosomePointer(), sz);
+    return best;
+}
+
+int main()
+{
+    // The helpers
+    ScratchArena arena(64);
+    uint8_t genes[sz];
+    for (int round = 0; round < 100; round++)
+    {
+        arena.reset();
+        for (int i = 0; i < sz; i++)
+            genes[i] = rand() % 256;
+        repairPermutation(genes, sz, arena);
+        if (!isPermutation(genes, sz))
+            return 1;
+    }
+    if (arena.capacity() < 2 * sz * sizeof(int)) // grown once to fit a whole round
+        return 1;
+
+    for (int i = 0; i < sz; i++)
+        genes[i] = (uint8_t)(sz - 1 - i);
+    uint8_t copy[sz];
+    memcpy(copy, genes, sz);
+    repairPermutation(genes, sz, arena); // already a permutation, left as is
+    if (memcmp(copy, genes, sz) != 0)
+        return 1;
+
+    int values[] = {-5, 3, 12, 40};
+    clampGenes(values, 4, 0, 10);
+    if (values[0] != 0 || values[1] != 3 || values[2] != 10 || values[3] != 10)
+        return 1;
+    int wrapped[] = {-1, 3, 11, 22};
+    wrapGenes(wrapped, 4, 0, 10);
+    if (wrapped[0] != 10 || wrapped[1] != 3 || wrapped[2] != 0 || wrapped[3] != 0)
+        return 1;
+
+    // The batch repair in the solver: only valid tours, the same run on 1 or 4 threads
+    bool valid1, valid4;
+    Individual<Chromosome> best1 = run(1, valid1);
+    Individual<Chromosome> best4 = run(4, valid4);
+    if (!valid1 || !valid4 || repairCalls == 0)
+        return 1;
+    if (best1.getFitness() != best4.getFitness() || memcmp(best1.getChromosomePointer(), best4.getChromosomePointer(), sz) != 0)
+        return 1;
+    return 0;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file test_reproducible.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the reproducible mode (Philox4x32-10 streams)
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+struct Chromosome
+{
+    uint8_t genes[16];
+};
+
+vector<Chromosome> evaluated;
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    double scoure = 0;
+    for (int i = 0; i < 16; i++)
+        scoure += (chromosome.genes[i] % 7) * (i % 3 + 1);
+    return scoure;
+}
+
+double recordingFitnessFunction(Chromosome &chromosome)
+{
+    evaluated.push_back(chromosome);
+    return fitnessFunction(chromosome);
+}
+
+Individual<Chromosome> run(int threadsCount, bool pipelined)
+{
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 40, 2, 15, Selection::MixSelection, Crossover::MixCrossover);
+    ga.setSeed(42);
+    ga.setThreadsCount(threadsCount);
+    ga.setPipelinedEvaluation(pipelined, 7);
+    ga.setLocalSearch(LocalSearch::BitFlip, 3, 20);
+    ga.initializePopulation(100);
+    return ga.solve();
+}
+
+int main()
+{
+    // Known-answer vectors of Random123
+    uint32_t counter[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, key[2] = {0xa4093822, 0x299f31d0}, output[4];
+    philox4x32(counter, key, output);
+    if (output[0] != 0xd16cfe09 || output[1] != 0x94fdcceb || output[2] != 0x5001e420 || output[3] != 0x24126ea1)
+        return 1;
+
+    // The same run with 1 thread and with the pipelined evaluation on 4 threads
+    Individual<Chromosome> serial = run(1, false), parallel = run(4, true);
+    if (serial.getFitness() != parallel.getFitness() || memcmp(serial.getChromosomePointer(), parallel.getChromosomePointer(), sizeof(Chromosome)) != 0)
+        return 1;
+
+    // Offspring i of generation g is the evaluation populationSize + g * offspringCount + i.
+    const int populationSize = 100, offspringCount = 85, generation = 5;
+    GeneticAlgorithm<Chromosome> recorded(recordingFitnessFunction, true, generation + 1);
+    recorded.setSeed(7);
+    recorded.initializePopulation(populationSize);
+    recorded.solve();
+
+    GeneticAlgorithm<Chromosome> replay(fitnessFunction, true, generation);
+    replay.setSeed(7);
+    replay.initializePopulation(populationSize);
+    replay.solve();
+    for (int i = 0; i < offspringCount; i++)
+    {
+        Chromosome offspring = replay.regenerateOffspring(generation, i);
+        if (memcmp(&offspring, &evaluated[populationSize + generation * offspringCount + i], sizeof(Chromosome)) != 0)
+            return 1;
+    }
+    return 0;
+}
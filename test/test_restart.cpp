@@ -0,0 +1,132 @@
+/**
+ * @file test_restart.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the restart strategy (IPOP) and the evaluation of the new populations
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+#include <atomic>
+
+using namespace std;
+
+struct Chromosome
+{
+    uint8_t genes[8];
+};
+
+atomic<int> syncCalls(0), asyncCalls(0);
+
+double score(Chromosome &chromosome)
+{
+    // A plateau: three small genes are the best the run can do, then it stagnates.
+    int small = 0;
+    for (int i = 0; i < 8; i++)
+        if (chromosome.genes[i] < 16)
+            ++small;
+    return min(small, 3);
+}
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    ++syncCalls;
+    return score(chromosome);
+}
+
+void asyncFitnessFunction(Chromosome &chromosome, function<void(double)> done)
+{
+    ++asyncCalls;
+    done(score(chromosome));
+}
+
+bool run(bool async)
+{
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 300);
+    ga.setVerbose(false);
+    ga.setSeed(11);
+    ga.setRestartStrategy(5, 2.0, 2);
+    if (async)
+        ga.setAsyncFitnessFunction(asyncFitnessFunction);
+    ga.initializePopulation(20);
+    syncCalls = asyncCalls = 0;
+    Individual<Chromosome> best = ga.solve();
+
+    if (ga.getRestartsCount() != 2 || best.getFitness() != 3)
+        return false;
+    // Each restart doubles the population, and every new individual is evaluated.
+    vector<Individual<Chromosome>> population = ga.getPopulation();
+    if (population.size() != 80)
+        return false;
+    for (Individual<Chromosome> &individual : population)
+        if (individual.getFitness() != score(*(Chromosome *)individual.getChromosomePointer()))
+            return false;
+    // With an asynchronous fitness function, the restarts use it too.
+    return async ? syncCalls == 0 && asyncCalls > 0 : syncCalls > 0;
+}
+
+// The population stops growing at the max size
+bool runCapped()
+{
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 300);
+    ga.setVerbose(false);
+    ga.setSeed(12);
+    ga.setRestartStrategy(5, 10.0, 3, 10, 500);
+    ga.initializePopulation(20);
+    ga.solve();
+    return ga.getRestartsCount() == 3 && ga.getPopulation().size() == 500;
+}
+
+shared_ptr<CancellationToken> token;
+atomic<int> cancelAfter(-1);
+
+double cancellingFitnessFunction(Chromosome &chromosome)
+{
+    if (++syncCalls == cancelAfter)
+        token->cancel();
+    return score(chromosome);
+}
+
+// A cancellation in the middle of a restart stops it after the current chunk, with the old population
+bool runCancelled()
+{
+    GeneticAlgorithm<Chromosome> ga(cancellingFitnessFunction, true, 300);
+    ga.setVerbose(false);
+    ga.setSeed(11);
+    ga.setRestartStrategy(5, 1000.0, 1);
+    token = make_shared<CancellationToken>();
+    ga.setCancellationToken(token);
+    syncCalls = 0;
+    ga.initializePopulation(20);
+    int beforeRestart = 0;
+    while (ga.getRestartsCount() == 0 && !ga.isTerminated())
+    {
+        beforeRestart = syncCalls;
+        ga.step(1);
+    }
+    if (ga.getRestartsCount() != 1)
+        return false;
+
+    // The same run again, cancelled in the first chunk of the restart population (20000 individuals)
+    GeneticAlgorithm<Chromosome> cancelled(cancellingFitnessFunction, true, 300);
+    cancelled.setVerbose(false);
+    cancelled.setSeed(11);
+    cancelled.setRestartStrategy(5, 1000.0, 1);
+    cancelled.setCancellationToken(token);
+    token->reset();
+    syncCalls = 0;
+    cancelAfter = beforeRestart + 10;
+    cancelled.initializePopulation(20);
+    cancelled.solve();
+    cancelAfter = -1;
+    return cancelled.getRestartsCount() == 0 && syncCalls <= beforeRestart + 20 && cancelled.getPopulation().size() == 20;
+}
+
+int main()
+{
+    if (!run(false) || !run(true) || !runCapped() || !runCancelled())
+        return 1;
+    return 0;
+}
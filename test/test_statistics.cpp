@@ -0,0 +1,120 @@
+/**
+ * @file test_statistics.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the quantiles and the Friedman race of the tuner against known values, and the checkpoints of the tuner
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "Tuner.h"
+#include <math.h>
+
+bool near(double value, double expected, double tolerance)
+{
+    return fabs(value - expected) <= tolerance;
+}
+
+bool testQuantiles()
+{
+    // Tables of the normal, Student and chi-square distributions
+    if (!near(normalQuantile(0.5), 0, 1e-6) || !near(normalQuantile(0.975), 1.959964, 4.5e-4) ||
+        !near(normalQuantile(0.05), -1.644854, 4.5e-4) || !near(normalQuantile(0.999), 3.090232, 4.5e-4) ||
+        normalQuantile(0.001) != -normalQuantile(0.999))
+        return false;
+    if (!near(studentQuantile(0.975, 1), 12.706205, 1e-5) || !near(studentQuantile(0.975, 2), 4.302653, 1e-5) ||
+        !near(studentQuantile(0.975, 5), 2.570582, 2e-3) || !near(studentQuantile(0.975, 10), 2.228139, 2e-3) ||
+        !near(studentQuantile(0.975, 14), 2.144787, 2e-3) || !near(studentQuantile(0.975, 30), 2.042272, 2e-3))
+        return false;
+    if (!near(chiSquareQuantile(0.95, 2), 5.991465, 0.06) || !near(chiSquareQuantile(0.95, 3), 7.814728, 0.05) ||
+        !near(chiSquareQuantile(0.95, 10), 18.307038, 0.02))
+        return false;
+    return true;
+}
+
+bool testFriedmanRace()
+{
+    vector<bool> eliminated;
+    vector<double> meanRanks;
+
+    // Configuration 0 is the best on every block, 1 and 2 take turns: statistic 12, threshold 2.145 * sqrt(64 / 14)
+    vector<vector<double>> results;
+    for (int i = 0; i < 8; i++)
+        results.push_back(i % 2 ? vector<double>{1, 2, 3} : vector<double>{1, 3, 2});
+    if (!friedmanRace(results, 0.05, eliminated, meanRanks) || eliminated[0] || !eliminated[1] || !eliminated[2] ||
+        meanRanks[0] != 1 || meanRanks[1] != 2.5 || meanRanks[2] != 2.5)
+        return false;
+
+    // 0 and 1 are close (rank sums 11 and 13, threshold about 4.4), 2 is always the worst
+    results.clear();
+    for (int i = 0; i < 8; i++)
+        results.push_back(i < 5 ? vector<double>{0.1, 0.2, 0.9} : vector<double>{0.2, 0.1, 0.9});
+    if (!friedmanRace(results, 0.05, eliminated, meanRanks) || eliminated[0] || eliminated[1] || !eliminated[2] ||
+        meanRanks[0] != 11.0 / 8 || meanRanks[1] != 13.0 / 8 || meanRanks[2] != 3)
+        return false;
+
+    // A Latin square: the same rank sums, the test does not reject
+    results = {{1, 2, 3}, {2, 3, 1}, {3, 1, 2}};
+    if (friedmanRace(results, 0.05, eliminated, meanRanks) || eliminated[0] || eliminated[1] || eliminated[2] ||
+        meanRanks[0] != 2 || meanRanks[1] != 2 || meanRanks[2] != 2)
+        return false;
+
+    // Every block is a tie, the tied configurations share the mean rank
+    results = {{5, 5, 5}, {7, 7, 7}};
+    if (friedmanRace(results, 0.05, eliminated, meanRanks) || meanRanks[0] != 2 || meanRanks[1] != 2 || meanRanks[2] != 2)
+        return false;
+
+    // Not enough blocks
+    results = {{1, 2, 3}};
+    if (friedmanRace(results, 0.05, eliminated, meanRanks) || eliminated.size() != 3)
+        return false;
+    return true;
+}
+
+struct Chromosome
+{
+    uint8_t genes[16];
+};
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    double scoure = 0;
+    for (int i = 0; i < 16; i++)
+        scoure += __builtin_popcount(chromosome.genes[i] ^ (uint8_t)(37 * i));
+    return scoure;
+}
+
+// The runs go on from one checkpoint to the next: each seed ends like one uninterrupted solve()
+bool testTunerCheckpoints()
+{
+    TunerConfiguration configuration;
+    configuration.selection = MixSelection;
+    configuration.crossover = MixCrossover;
+    configuration.populationSize = 60;
+    Tuner<Chromosome> tuner(fitnessFunction);
+    tuner.addConfiguration(configuration);
+    tuner.setThreadsCount(2);
+    vector<TunerResult> results = tuner.tune(3, 40, 10);
+    if (results.size() != 1 || results[0].generations != 40 || results[0].fitness.size() != 3 || tuner.getGenerationsCount() != 3 * 40)
+        return false;
+
+    for (int s = 0; s < 3; s++)
+    {
+        GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 40, configuration.mutationPercentage, configuration.elitePercentage,
+                                        configuration.selection, configuration.crossover);
+        ga.setVerbose(false);
+        ga.setSeed(s + 1);
+        ga.initializePopulation(configuration.populationSize);
+        if (ga.solve().getFitness() != results[0].fitness[s])
+            return false;
+    }
+    return true;
+}
+
+int main()
+{
+    if (!testQuantiles() || !testFriedmanRace() || !testTunerCheckpoints())
+        return 1;
+    return 0;
+}
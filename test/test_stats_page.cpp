@@ -0,0 +1,84 @@
+/**
+ * @file test_stats_page.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the shared-memory stats page
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+#include <unistd.h>
+
+using namespace std;
+
+struct Chromosome
+{
+    uint8_t genes[13]; // not a multiple of 8 bytes
+};
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    double scoure = 0;
+    for (int i = 0; i < 13; i++)
+        scoure += chromosome.genes[i] % 17;
+    return scoure;
+}
+
+int main()
+{
+    const string name = "/ga_test_stats_" + to_string(getpid());
+
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 300);
+    ga.setVerbose(false);
+    ga.initializePopulation(200);
+    if (!ga.setStatsPage(name))
+        return 1;
+
+    StatsPage monitor;
+    if (!monitor.attach(name) || monitor.getChromosomeSize() != sizeof(Chromosome) || monitor.getWriterPid() != (uint64_t)getpid())
+        return 1;
+    StatsSnapshot snapshot;
+    Chromosome chromosome;
+    if (monitor.read(snapshot, &chromosome)) // nothing published yet
+        return 1;
+
+    // A reader polling during the run only sees consistent pages: the chromosome matches its fitness, the generations grow.
+    atomic<bool> done(false);
+    bool consistent = true;
+    thread reader([&]()
+                  {
+                      uint64_t lastGeneration = 0;
+                      while (!done.load())
+                      {
+                          StatsSnapshot s;
+                          Chromosome c;
+                          if (!monitor.read(s, &c))
+                              continue;
+                          consistent = consistent && s.bestFitness == fitnessFunction(c) && s.generation >= lastGeneration;
+                          lastGeneration = s.generation;
+                      } });
+    Individual<Chromosome> best = ga.solve();
+    done = true;
+    reader.join();
+    if (!consistent)
+        return 1;
+
+    uint64_t version;
+    if (!monitor.read(snapshot, &chromosome, &version) || snapshot.state != StatsFinished || snapshot.generation != 300 || version != 301)
+        return 1;
+    if (snapshot.evaluations != ga.getEvaluationsCount() || snapshot.bestFitness != best.getFitness() ||
+        memcmp(&chromosome, best.getChromosomePointer(), sizeof(Chromosome)) != 0)
+        return 1;
+    if (snapshot.meanFitness > snapshot.bestFitness || snapshot.diversity < 0 || snapshot.diversity > 1 ||
+        snapshot.breed_ns <= 0 || snapshot.generation_ns < snapshot.breed_ns || snapshot.elapsed_ns <= 0 || snapshot.evaluationsPerSecond <= 0)
+        return 1;
+
+    // The segment goes away with the page of the solver.
+    ga.disableStatsPage();
+    StatsPage gone;
+    if (gone.attach(name))
+        return 1;
+    return 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file test_step.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the incremental step() API and the warm start
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+struct Chromosome
+{
+    uint8_t genes[16];
+};
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    double scoure = 0;
+    for (int i = 0; i < 16; i++)
+        scoure += (chromosome.genes[i] % 7) * (i % 3 + 1);
+    return scoure;
+}
+
+// The problem changes a little: the last gene counts no more
+double changedFitnessFunction(Chromosome &chromosome)
+{
+    double scoure = 0;
+    for (int i = 0; i < 15; i++)
+        scoure += (chromosome.genes[i] % 7) * (i % 3 + 1);
+    return scoure;
+}
+
+void setup(GeneticAlgorithm<Chromosome> &ga)
+{
+    ga.setVerbose(false);
+    ga.setSeed(7);
+    ga.setRestartStrategy(20);
+    ga.initializePopulation(60);
+}
+
+int main()
+{
+    // One solve() of 100 generations
+    GeneticAlgorithm<Chromosome> solved(fitnessFunction, true, 100, 2, 15, Selection::MixSelection, Crossover::MixCrossover);
+    setup(solved);
+    Individual<Chromosome> expected = solved.solve();
+
+    // The same run in steps of 1, 9, 40 and 50 generations
+    GeneticAlgorithm<Chromosome> stepped(fitnessFunction, true, 100, 2, 15, Selection::MixSelection, Crossover::MixCrossover);
+    setup(stepped);
+    uint64_t steps[] = {1, 9, 40, 50};
+    Individual<Chromosome> best = stepped.step(0);
+    for (uint64_t n : steps)
+    {
+        if (stepped.isTerminated())
+            return 1;
+        best = stepped.step(n);
+    }
+    stepped.step(1); // the max generation is reached
+    if (!stepped.isTerminated() || stepped.getGeneration() != 100)
+        return 1;
+    if (best.getFitness() != expected.getFitness() || memcmp(best.getChromosomePointer(), expected.getChromosomePointer(), sizeof(Chromosome)) != 0)
+        return 1;
+
+    // Warm start: every individual is scored with the new function, then the run goes on.
+    stepped.rescorePopulation(changedFitnessFunction);
+    best = stepped.step(0);
+    if (best.getFitness() != changedFitnessFunction(*(Chromosome *)best.getChromosomePointer()))
+        return 1;
+    stepped.terminationConditions.setMaxGeneration(150);
+    best = stepped.step(50);
+    if (best.getFitness() != changedFitnessFunction(*(Chromosome *)best.getChromosomePointer()) || stepped.getGeneration() != 150)
+        return 1;
+    return 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file test_trace.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief test the per-generation trace (binary and CSV)
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "GeneticAlgorithm.h"
+#include <fstream>
+
+using namespace std;
+
+struct Chromosome
+{
+    uint8_t genes[10];
+};
+
+double fitnessFunction(Chromosome &chromosome)
+{
+    double scoure = 0;
+    for (int i = 0; i < 10; i++)
+        scoure += chromosome.genes[i] % 13;
+    return scoure;
+}
+
+int main()
+{
+    const char *binaryPath = "test_trace.bin", *csvPath = "test_trace.csv";
+
+    GeneticAlgorithm<Chromosome> ga(fitnessFunction, true, 1000);
+    ga.setVerbose(false);
+    ga.initializePopulation(40);
+    if (!ga.setTrace(binaryPath))
+        return 1;
+    ga.step(30);
+    ga.disableTrace(); // the remaining records are written
+
+    vector<GenerationRecord> records;
+    if (!TraceWriter::read(binaryPath, records) || records.size() != 30)
+        return 1;
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        GenerationRecord &r = records[i];
+        if (r.generation != i || r.end_ns < r.start_ns || r.bestFitness < r.meanFitness || r.meanFitness < r.worstFitness ||
+            r.diversity < 0 || r.diversity > 1 || (i > 0 && (r.evaluations <= records[i - 1].evaluations || r.start_ns < records[i - 1].end_ns)))
+            return 1;
+    }
+    if (records.back().evaluations != ga.getEvaluationsCount())
+        return 1;
+
+    // CSV, and a full ring buffer drops records instead of blocking the run.
+    {
+        shared_ptr<TraceWriter> trace = make_shared<TraceWriter>(csvPath, TraceCSV, 4, 60000);
+        ga.setTrace(trace);
+        ga.step(10);
+        ga.disableTrace();
+        trace->flush();
+        if (trace->getDroppedCount() != 6)
+            return 1;
+    }
+    ifstream csv(csvPath);
+    string line;
+    int lines = 0;
+    while (getline(csv, line))
+        ++lines;
+    if (lines != 1 + 4) // header and the records kept
+        return 1;
+
+    remove(binaryPath);
+    remove(csvPath);
+    return 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file ga_monitor.cpp
+ * @author Ali Marouf (https://github.com/AliMarouf97)
+ * @brief print the live statistics of a running solver (see GeneticAlgorithm::setStatsPage)
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "StatsPage.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <thread>
+using namespace std;
+
+// usage: ga_monitor /name [interval_ms] [--once]
+// Prints a line each time the solver publishes a generation, until the run ends or the segment is removed.
+
+const char *stateName(uint64_t state)
+{
+    return state == StatsRunning ? "running" : (state == StatsFinished ? "finished" : "stopped");
+}
+
+void print(const StatsSnapshot &s, const vector<uint8_t> &chromosome)
+{
+    printf("gen %llu  best %.10g  mean %.10g  diversity %.4f  evals %llu (%.0f/s)  elapsed %.3f s  %s\n",
+           (unsigned long long)s.generation, s.bestFitness, s.meanFitness, s.diversity, (unsigned long long)s.evaluations,
+           s.evaluationsPerSecond, s.elapsed_ns * 1e-9, stateName(s.state));
+    printf("    phases (ms): rank %.3f  local search %.3f  breed %.3f  dedup %.3f  generation %.3f\n",
+           s.rank_ns * 1e-6, s.localSearch_ns * 1e-6, s.breed_ns * 1e-6, s.dedup_ns * 1e-6, s.generation_ns * 1e-6);
+    printf("    best chromosome:");
+    for (size_t i = 0; i < chromosome.size() && i < 32; i++)
+        printf(" %02x", chromosome[i]);
+    printf(chromosome.size() > 32 ? " ...\n" : "\n");
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s /name [interval_ms] [--once]\n", argv[0]);
+        return 2;
+    }
+    int interval_ms = 500;
+    bool once = false;
+    for (int i = 2; i < argc; i++)
+        if (strcmp(argv[i], "--once") == 0)
+            once = true;
+        else
+            interval_ms = atoi(argv[i]);
+
+    StatsPage page;
+    if (!page.attach(argv[1]))
+    {
+        fprintf(stderr, "no stats page %s\n", argv[1]);
+        return 1;
+    }
+    printf("attached to %s (pid %llu, chromosome %d bytes)\n", argv[1], (unsigned long long)page.getWriterPid(), page.getChromosomeSize());
+
+    vector<uint8_t> chromosome(page.getChromosomeSize());
+    uint64_t last = 0;
+    for (;;)
+    {
+        // The solver removes the segment when it is done, the mapping still holds its last snapshot.
+        // A new page with the same name is another run.
+        StatsPage current;
+        bool alive = current.attach(argv[1]) && current.getWriterPid() == page.getWriterPid();
+
+        StatsSnapshot snapshot;
+        uint64_t version;
+        if (page.read(snapshot, chromosome.data(), &version) && version != last)
+        {
+            last = version;
+            print(snapshot, chromosome);
+            if (snapshot.state != StatsRunning)
+                return 0;
+        }
+        if (once)
+            return last != 0 ? 0 : 1;
+        if (!alive)
+        {
+            printf("the solver is gone\n");
+            return 0;
+        }
+        this_thread::sleep_for(chrono::milliseconds(interval_ms));
+    }
+}